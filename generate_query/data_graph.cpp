@@ -0,0 +1,44 @@
+#include "data_graph.h"
+#include <fstream>
+#include <iostream>
+
+bool DataGraph::load(const std::string &file) {
+    std::ifstream graph_descriptor(file, std::ios::binary);
+
+    if (!graph_descriptor.is_open()) {
+        std::cout << "wrong path! (data graph)" << std::endl;
+        return false;
+    }
+
+    ui size_vertex_num_offset = 0;
+    graph_descriptor.read((char*)&vertex_num, sizeof(ui));
+    graph_descriptor.read((char*)&size_vertex_num_offset, sizeof(ui));
+    label_num = size_vertex_num_offset - 1;
+    vertex_num_offset.resize(size_vertex_num_offset);
+    graph_descriptor.read((char*)vertex_num_offset.data(), sizeof(ui) * size_vertex_num_offset);
+
+    std::vector<ui> in_degree(vertex_num);
+    std::vector<ui> out_degree(vertex_num);
+    graph_descriptor.read((char*)in_degree.data(), sizeof(ui) * vertex_num);
+    graph_descriptor.read((char*)out_degree.data(), sizeof(ui) * vertex_num);
+
+    in_offset.resize(vertex_num + 1);
+    out_offset.resize(vertex_num + 1);
+    in_offset[0] = 0;
+    out_offset[0] = 0;
+    for (ui i = 0; i < vertex_num; i++) {
+        in_offset[i + 1] = in_offset[i] + in_degree[i];
+        out_offset[i + 1] = out_offset[i] + out_degree[i];
+    }
+
+    in_neighbors.resize(in_offset[vertex_num]);
+    out_neighbors.resize(out_offset[vertex_num]);
+    graph_descriptor.read((char*)in_neighbors.data(), sizeof(VertexID) * in_neighbors.size());
+    graph_descriptor.read((char*)out_neighbors.data(), sizeof(VertexID) * out_neighbors.size());
+
+    if (!graph_descriptor) {
+        std::cout << "truncated data graph!" << std::endl;
+        return false;
+    }
+    return true;
+}
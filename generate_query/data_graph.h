@@ -0,0 +1,40 @@
+#ifndef DATA_GRAPH_H
+#define DATA_GRAPH_H
+
+#include "type.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/*
+ * Data graph written by CSVReader, fixed layout only (optional sections are
+ * skipped). Labels own contiguous ID ranges and neighbor lists are sorted.
+ */
+struct DataGraph {
+    ui vertex_num;
+    ui label_num;
+    std::vector<ui> vertex_num_offset;
+    std::vector<uint64_t> in_offset;
+    std::vector<uint64_t> out_offset;
+    std::vector<VertexID> in_neighbors;
+    std::vector<VertexID> out_neighbors;
+
+    DataGraph() : vertex_num(0), label_num(0) {}
+
+    bool load(const std::string &file);
+
+    LabelID getLabel(VertexID v) const {
+        return std::upper_bound(vertex_num_offset.begin(), vertex_num_offset.end(), v) - vertex_num_offset.begin() - 1;
+    }
+
+    ui getInDegree(VertexID v) const { return in_offset[v + 1] - in_offset[v]; }
+    ui getOutDegree(VertexID v) const { return out_offset[v + 1] - out_offset[v]; }
+    const VertexID* getInNeighbors(VertexID v) const { return in_neighbors.data() + in_offset[v]; }
+    const VertexID* getOutNeighbors(VertexID v) const { return out_neighbors.data() + out_offset[v]; }
+
+    bool hasEdge(VertexID u, VertexID v) const {
+        return std::binary_search(getOutNeighbors(u), getOutNeighbors(u) + getOutDegree(u), v);
+    }
+};
+
+#endif
@@ -0,0 +1,51 @@
+#include "graph_stats.h"
+#include <fstream>
+#include <iostream>
+
+bool GraphStats::load(const std::string &file) {
+    std::ifstream descriptor(file, std::ios::binary);
+
+    if (!descriptor.is_open()) {
+        std::cout << "wrong path! (statistics file)" << std::endl;
+        return false;
+    }
+
+    ui magic = 0;
+    ui bucket_num = 0;
+    descriptor.read((char*)&magic, sizeof(ui));
+    descriptor.read((char*)&label_num, sizeof(ui));
+    descriptor.read((char*)&bucket_num, sizeof(ui));
+    if (magic != GRAPH_STATS_MAGIC || bucket_num != DEGREE_BUCKET_NUM) {
+        std::cout << "not a statistics file! (" << file << ")" << std::endl;
+        label_num = 0;
+        return false;
+    }
+
+    vertex_count.resize(label_num);
+    descriptor.read((char*)vertex_count.data(), sizeof(ui) * label_num);
+    if ((3 + label_num) % 2 == 1) {
+        ui padding = 0;
+        descriptor.read((char*)&padding, sizeof(ui));
+    }
+    pairs.resize((size_t)label_num * label_num);
+    descriptor.read((char*)pairs.data(), sizeof(LabelPairStats) * pairs.size());
+
+    if (!descriptor) {
+        std::cout << "truncated statistics file!" << std::endl;
+        label_num = 0;
+        return false;
+    }
+    return true;
+}
+
+double countDegreeAtLeast(const uint64_t* histogram, ui min_degree) {
+    // a bucket counts if any degree in [2^k, 2^(k+1)) reaches min_degree
+    double count = 0;
+    for (ui bucket = 0; bucket < DEGREE_BUCKET_NUM; bucket++) {
+        uint64_t bucket_max = (2ULL << bucket) - 1;
+        if (bucket_max >= min_degree) {
+            count += histogram[bucket];
+        }
+    }
+    return count;
+}
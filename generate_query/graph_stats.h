@@ -0,0 +1,50 @@
+#ifndef GRAPH_STATS_H
+#define GRAPH_STATS_H
+
+#include "type.h"
+#include <string>
+#include <vector>
+
+/*
+ * Statistics file (<graph>.stats) written by CSVReader -stats.
+ *
+ * Layout:
+ *   ui magic, ui label_num, ui bucket_num, ui vertex_count[label_num], padding to 8 bytes,
+ *   LabelPairStats pairs[label_num * label_num], pairs[a * label_num + b] for edges a -> b
+ * Histogram bucket k counts vertices whose degree restricted to the pair is in
+ * [2^k, 2^(k+1)); vertices without such edges are not counted.
+ */
+#define GRAPH_STATS_MAGIC 0x31545347     // "GST1"
+#define DEGREE_BUCKET_NUM 32
+
+struct LabelPairStats {
+    uint64_t edge_num;
+    ui distinct_src;                        // label a vertices with at least one such edge
+    ui distinct_dest;                       // label b vertices with at least one such edge
+    ui max_out_degree;                      // most b out-neighbors of one a vertex
+    ui max_in_degree;                       // most a in-neighbors of one b vertex
+    double avg_out_degree;                  // over distinct_src
+    double avg_in_degree;                   // over distinct_dest
+    uint64_t out_degree_histogram[DEGREE_BUCKET_NUM];
+    uint64_t in_degree_histogram[DEGREE_BUCKET_NUM];
+};
+
+struct GraphStats {
+    ui label_num;
+    std::vector<ui> vertex_count;
+    std::vector<LabelPairStats> pairs;
+
+    GraphStats() : label_num(0) {}
+
+    bool load(const std::string &file);
+
+    // statistics of the edges from label a to label b
+    const LabelPairStats& getPair(LabelID a, LabelID b) const {
+        return pairs[a * label_num + b];
+    }
+};
+
+// Vertices whose degree restricted to a label pair is at least min_degree, from a histogram
+double countDegreeAtLeast(const uint64_t* histogram, ui min_degree);
+
+#endif
@@ -1,6 +1,19 @@
 #include "type.h"
 #include "query_command.h"
+#include "query_convert.h"
+#include "query_sampler.h"
+#include "query_scale.h"
+#include "query_canonical.h"
+#include "query_section.h"
+#include "query_plan.h"
+#include "query_estimate.h"
+#include "query_symmetry.h"
+#include "query_workload.h"
+#include "utility/thread_pool.h"
+#include <dirent.h>
+#include <algorithm>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include <set>
 #include <cstring>
@@ -8,55 +21,214 @@
 
 #define NANOSECTOSEC(elapsed_time) ((elapsed_time)/(double)1000000000)
 
-void readLabelFile(std::string file, VertexID &label_num, VertexID* label_offset, char* labels_array, std::vector<std::string> &labels) {
-	std::ifstream label_descriptor(file, std::ios::binary);
+struct QueryTask {
+    std::string input_file;
+    std::string output_file;
+    std::string name;
+};
 
-	if (!label_descriptor.is_open()) {
-		std::cout << "wrong path! (label file)" << std::endl;
-	}
-
-	label_descriptor.read((char*)&label_num, sizeof(VertexID));
-
-	VertexID size_vertex_num_offset = label_num + 1;
-	label_offset = new VertexID[size_vertex_num_offset];
-    label_descriptor.read((char*)label_offset, sizeof(VertexID) * size_vertex_num_offset);
-
-    labels_array = new char[label_offset[label_num]];
-    label_descriptor.read((char*)labels_array, sizeof(char) * label_offset[label_num]);
-    std::string labels_string(labels_array);
+std::string baseName(const std::string &path) {
+    size_t pos = path.rfind('/');
+    return pos == std::string::npos ? path : path.substr(pos + 1);
+}
 
-    for (VertexID i = 0; i < label_num; i++) {
-    	std::string label = labels_string.substr(label_offset[i], label_offset[i + 1] - label_offset[i]);
+// Queries of a batch run, from every .graph file of a directory or from a manifest
+std::vector<QueryTask> listQueryTasks(const std::string &input_dir, const std::string &manifest, const std::string &output_dir) {
+    std::vector<QueryTask> tasks;
+
+    if (!input_dir.empty()) {
+        DIR* dir = opendir(input_dir.c_str());
+        if (dir == nullptr) {
+            std::cout << "wrong directory! (query directory)" << std::endl;
+            return tasks;
+        }
+        struct dirent* diread = readdir(dir);
+        while (diread != nullptr) {
+            std::string file_name(diread->d_name);
+            if (file_name.size() > 6 && file_name.compare(file_name.size() - 6, 6, ".graph") == 0) {
+                QueryTask task;
+                task.input_file = input_dir + "/" + file_name;
+                task.name = file_name;
+                tasks.push_back(task);
+            }
+            diread = readdir(dir);
+        }
+        closedir(dir);
+        std::sort(tasks.begin(), tasks.end(), [](const QueryTask &a, const QueryTask &b) { return a.name < b.name; });
+    } else {
+        // one query per line: input path, optionally followed by its output path
+        std::ifstream manifest_descriptor(manifest);
+        if (!manifest_descriptor.is_open()) {
+            std::cout << "wrong path! (manifest)" << std::endl;
+            return tasks;
+        }
+        std::string line;
+        while (std::getline(manifest_descriptor, line)) {
+            std::istringstream line_stream(line);
+            QueryTask task;
+            if (!(line_stream >> task.input_file) || task.input_file[0] == '#') {
+                continue;
+            }
+            line_stream >> task.output_file;
+            task.name = baseName(task.input_file);
+            tasks.push_back(task);
+        }
+    }
 
-    	if (label.find("_") != std::string::npos) {
-    		label = label.substr(label.find("_") + 1, label.length() - label.find("_") - 1);
-    	}
-    	labels.push_back(label);
+    // without an output directory only the manifest's own output paths are set
+    for (auto &task : tasks) {
+        if (task.output_file.empty() && !output_dir.empty()) {
+            task.output_file = output_dir + "/" + task.name;
+        }
     }
+    return tasks;
 }
 
+// Sections appended to every query, shared by all modes
+struct QueryAnnotations {
+    bool canonical;
+    bool dedup;
+    bool symmetry;
+    const GraphStats* stats;                // matching-order section if set
+    const DataGraph* graph;                 // cardinality-estimate section if set
+    ui estimate_sample_num;
+    uint64_t seed;
+
+    QueryAnnotations() : canonical(false), dedup(false), symmetry(false), stats(nullptr), graph(nullptr), estimate_sample_num(0), seed(0) {}
+};
+
+struct AnnotatedQuery {
+    std::string bytes;                      // the query graph followed by its sections
+    ui vertex_num;
+    ui edge_num;
+    uint64_t hash;
+    std::vector<ui> code;                   // canonical code, kept if duplicates are dropped
+    MatchingPlan plan;
+    bool has_plan;
+    EmbeddingEstimate estimate;
+    bool has_estimate;
+    SymmetryBreaking symmetry;
+    bool has_symmetry;
+
+    AnnotatedQuery() : vertex_num(0), edge_num(0), hash(0), has_plan(false), has_estimate(false), has_symmetry(false) {}
+};
+
+// Serialize a query with the sections requested by the annotations; index seeds its estimate
+void annotateQuery(const ConvertedQuery &query, const QueryAnnotations &annotations, ui index, AnnotatedQuery &result) {
+    std::ostringstream query_stream;
+    writeQuery(query_stream, query);
+    result.vertex_num = query.vertex_num;
+    result.edge_num = query.edge_num;
+
+    // the canonical search also yields the automorphisms the symmetry breaking starts from
+    CanonicalForm form;
+    if (annotations.canonical || annotations.symmetry) {
+        canonicalForm(query, form);
+    }
+    if (annotations.canonical) {
+        result.hash = form.hash;
+        writeQuerySectionHeader(query_stream, QuerySection::CanonicalHash, sizeof(uint64_t));
+        query_stream.write((char*)&form.hash, sizeof(uint64_t));
+        if (annotations.dedup) {
+            result.code.swap(form.code);
+        }
+    }
 
-void readQueryFile(std::string file, ui &edge_num, std::vector<std::pair<std::string, std::string> > &edges, 
-					std::set<std::string> &vertices) {
-	std::ifstream query_descriptor(file);
+    result.has_plan = annotations.stats != nullptr && computeMatchingPlan(query, *annotations.stats, result.plan);
+    if (result.has_plan) {
+        writeMatchingPlan(query_stream, result.plan);
+    }
 
-	if (!query_descriptor.is_open()) {
-		std::cout << "wrong path! (query file)" << std::endl;
-	}
+    result.has_estimate = annotations.graph != nullptr && annotations.estimate_sample_num != 0
+                          && query.vertex_num_offset.size() == annotations.graph->label_num + 1;
+    if (result.has_estimate) {
+        if (result.has_plan && !result.plan.cardinality.empty()) {
+            result.estimate.stats_estimate = result.plan.cardinality.back();
+        }
+        MatchingPlan order;
+        if (!result.has_plan) {
+            connectedOrder(query, *annotations.graph, order);
+        }
+        estimateBySampling(query, *annotations.graph, result.has_plan ? result.plan : order,
+                           annotations.estimate_sample_num, annotations.seed + 0xBF58476D1CE4E5B9ULL * (index + 1), result.estimate);
+        writeCardinalityEstimate(query_stream, result.estimate);
+    }
 
-	query_descriptor >> edge_num;
+    result.has_symmetry = annotations.symmetry;
+    if (result.has_symmetry) {
+        breakSymmetry(query.vertex_num, form.generators, result.symmetry);
+        writeSymmetryBreaking(query_stream, result.symmetry);
+    }
 
-	for (ui i = 0; i < edge_num; i++) {
-		std::string src;
-		std::string dest;
+    result.bytes = query_stream.str();
+}
 
-		query_descriptor >> src >> dest;
+// Keep the first query of every isomorphism class in task order, returns the number dropped
+ui dropDuplicates(const std::vector<AnnotatedQuery> &queries, std::vector<char> &kept) {
+    std::set<std::vector<ui> > seen;
+    ui duplicate_num = 0;
+    for (ui i = 0; i < queries.size(); i++) {
+        if (kept[i] && !seen.insert(queries[i].code).second) {
+            kept[i] = 0;
+            duplicate_num++;
+        }
+    }
+    return duplicate_num;
+}
 
-		edges.push_back(std::make_pair(src, dest));
+// Print the spread of the sampled estimates and write one "name |V| |E| sampled error stats" line per query
+void reportEstimates(const std::string &report_file, const std::vector<std::string> &names, const std::vector<AnnotatedQuery*> &queries) {
+    std::vector<double> estimates;
+    for (auto query : queries) {
+        if (query->has_estimate) {
+            estimates.push_back(query->estimate.sampled_estimate);
+        }
+    }
+    if (estimates.empty()) {
+        return;
+    }
+    std::sort(estimates.begin(), estimates.end());
+    printf("Estimated embeddings (min / median / max): %.4g / %.4g / %.4g\n",
+           estimates.front(), estimates[estimates.size() / 2], estimates.back());
 
-		vertices.insert(src);
-		vertices.insert(dest);
-	}
+    if (report_file.empty()) {
+        return;
+    }
+    std::ofstream report_descriptor(report_file);
+    report_descriptor << "# name vertex_num edge_num sampled_estimate relative_error stats_estimate" << std::endl;
+    for (ui i = 0; i < queries.size(); i++) {
+        const AnnotatedQuery &query = *queries[i];
+        if (!query.has_estimate) {
+            continue;
+        }
+        report_descriptor << names[i] << " " << query.vertex_num << " " << query.edge_num << " "
+                          << query.estimate.sampled_estimate << " " << query.estimate.relative_error << " "
+                          << query.estimate.stats_estimate << std::endl;
+    }
+    report_descriptor.close();
+}
+
+// Write kept queries to their files or into one workload file, in task order; false if some write failed
+bool storeQueries(const std::string &pack_file, const std::vector<std::string> &names, const std::vector<std::string> &files,
+                  const std::vector<AnnotatedQuery*> &queries) {
+    if (pack_file.empty()) {
+        bool stored = true;
+        for (ui i = 0; i < queries.size(); i++) {
+            std::ofstream query_descriptor(files[i], std::ios::binary);
+            query_descriptor.write(queries[i]->bytes.data(), queries[i]->bytes.size());
+            query_descriptor.close();
+            if (query_descriptor.fail()) {
+                std::cout << "cannot write query file " << files[i] << "!" << std::endl;
+                stored = false;
+            }
+        }
+        return stored;
+    }
+    std::vector<std::string> bytes;
+    for (auto query : queries) {
+        bytes.push_back(query->bytes);
+    }
+    return writeWorkload(pack_file, names, bytes);
 }
 
 int main(int argc, char **argv)
@@ -66,89 +238,378 @@ int main(int argc, char **argv)
     std::string input_query_graph_file = command.getIQueryGraphFile();
     std::string input_label_file = command.getLabelFilePath();
     std::string output_query_graph_file = command.getOQueryGraphFile();
+    std::string input_query_dir = command.getIQueryDirectory();
+    std::string input_manifest = command.getManifestFile();
+    std::string output_query_dir = command.getOQueryDirectory();
+    std::string output_pack_file = command.getPackFile();
+    ui thread_num = command.getThreadNum();
+    std::string input_data_graph_file = command.getDataGraphFile();
+    bool dedup = command.getDedup();
+    bool canonical = command.getCanonicalHash() || dedup;
+    bool symmetry = command.getSymmetry();
+    std::string input_stats_file = command.getStatsFile();
+    ui estimate_sample_num = command.getEstimateSampleNum();
+    std::string output_report_file = command.getReportFile();
+    bool batch_mode = !input_query_dir.empty() || !input_manifest.empty();
+    bool sampling_mode = !input_data_graph_file.empty() && command.getSampleNum() != 0;
+    std::string scale_sizes = command.getScaleSizes();
+    bool scale_mode = !sampling_mode && !input_data_graph_file.empty() && !scale_sizes.empty();
 
     std::cout << "Command Line:" << std::endl;
-    std::cout << "\tInput Query Graph: " << input_query_graph_file << std::endl;
-    std::cout << "\tLabel: " << input_label_file << std::endl;
-    std::cout << "\tOutput Query Graph: " << output_query_graph_file << std::endl;
+    if (sampling_mode) {
+        std::cout << "\tData Graph: " << input_data_graph_file << std::endl;
+        std::cout << "\tLabel: " << input_label_file << std::endl;
+        std::cout << "\tSamples: " << command.getSampleNum() << " x " << command.getSampleSize() << " vertices ("
+                  << command.getSampleMethod() << ", density " << command.getSampleDensity() << ", seed " << command.getSeed() << ")" << std::endl;
+        std::cout << "\tOutput Queries: " << (output_pack_file.empty() ? output_query_dir : output_pack_file) << std::endl;
+    } else if (scale_mode) {
+        std::cout << "\tData Graph: " << input_data_graph_file << std::endl;
+        std::cout << "\tLabel: " << input_label_file << std::endl;
+        std::cout << "\tSeed Queries: " << (batch_mode ? (input_query_dir.empty() ? input_manifest : input_query_dir) : input_query_graph_file) << std::endl;
+        std::cout << "\tVariants: " << scale_sizes << " vertices, sparse and dense (seed " << command.getSeed() << ")" << std::endl;
+        std::cout << "\tOutput Queries: " << (output_pack_file.empty() ? output_query_dir : output_pack_file) << std::endl;
+    } else if (batch_mode) {
+        std::cout << "\tInput Queries: " << (input_query_dir.empty() ? input_manifest : input_query_dir) << std::endl;
+        std::cout << "\tLabel: " << input_label_file << std::endl;
+        std::cout << "\tOutput Queries: " << (output_pack_file.empty() ? output_query_dir : output_pack_file) << std::endl;
+    } else {
+        std::cout << "\tInput Query Graph: " << input_query_graph_file << std::endl;
+        std::cout << "\tLabel: " << input_label_file << std::endl;
+        std::cout << "\tOutput Query Graph: " << output_query_graph_file << std::endl;
+    }
+    std::cout << "\tCanonical Hash: " << (canonical ? "yes" : "no") << (dedup ? " (dedup)" : "") << std::endl;
+    std::cout << "\tSymmetry Breaking: " << (symmetry ? "yes" : "no") << std::endl;
+    std::cout << "\tStatistics: " << (input_stats_file.empty() ? "none" : input_stats_file) << std::endl;
+    std::cout << "\tEstimate Samples: " << estimate_sample_num << std::endl;
     std::cout << "--------------------------------------------------------------------" << std::endl;
 
+    // sampling and scaling draw from the data graph, without it they would fall through to conversion
+    if ((command.getSampleNum() != 0 || !scale_sizes.empty()) && input_data_graph_file.empty()) {
+        std::cout << "sampling and scaling need the data graph! (-dg)" << std::endl;
+        return 1;
+    }
+
+    // generated queries are named by the tool, so they need somewhere to go
+    if ((sampling_mode || scale_mode) && output_query_dir.empty() && output_pack_file.empty()) {
+        std::cout << "no output for the generated queries! (-oqd or -pack)" << std::endl;
+        return 1;
+    }
+
     std::cout << "Reading label profile..." << std::endl;
 
 auto start = std::chrono::high_resolution_clock::now();
 
-    VertexID label_num;
-    VertexID* label_offset = NULL;
-    char* labels_array = NULL;
-    std::vector<std::string> labels;
-    readLabelFile(input_label_file, label_num, label_offset, labels_array, labels);
+    LabelProfile profile;
+    profile.load(input_label_file);
+    ui label_num = profile.label_num;
     for (ui i = 0; i < label_num; i++) {
-    	std::cout << "\t" << labels[i] << std::endl;
+    	std::cout << "\t" << profile.labels[i] << std::endl;
     }
     std::cout << "|\u03A3|: " << label_num << std::endl;
 
+    // label-pair statistics of the data graph, matching orders are planned with them
+    GraphStats stats;
+    if (!input_stats_file.empty() && stats.load(input_stats_file) && stats.label_num != label_num) {
+        std::cout << "statistics file does not match the label file!" << std::endl;
+    }
+
 auto end = std::chrono::high_resolution_clock::now();
 double load_label_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 
-    std::cout << "--------------------------------------------------------------------" << std::endl;
-    std::cout << "Reading input query graph..." << std::endl;
+    // the data graph is needed to sample queries and to estimate their embeddings
+    DataGraph graph;
+    double load_graph_time_in_ns = 0;
+    if (!input_data_graph_file.empty()) {
+        std::cout << "--------------------------------------------------------------------" << std::endl;
+        std::cout << "Reading data graph..." << std::endl;
 
 start = std::chrono::high_resolution_clock::now();
 
-    ui edge_num;
-    std::vector<std::pair<std::string, std::string> > edges;
-    std::set<std::string> vertices;
-    readQueryFile(input_query_graph_file, edge_num, edges, vertices);
+        graph.load(input_data_graph_file);
+        std::cout << "|V|: " << graph.vertex_num << std::endl;
+        std::cout << "|E|: " << graph.out_neighbors.size() << std::endl;
+        if (graph.label_num != label_num) {
+            std::cout << "label file does not match the data graph!" << std::endl;
+        }
+
+end = std::chrono::high_resolution_clock::now();
+load_graph_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    } else if (estimate_sample_num != 0) {
+        std::cout << "estimates need the data graph! (-dg)" << std::endl;
+    }
 
-    ui vertex_num = vertices.size();
-    ui size_vertex_num_offset = label_num + 1;
-    ui* vertex_num_offset = new ui[size_vertex_num_offset];
-    std::memset(vertex_num_offset, 0, size_vertex_num_offset * sizeof(ui));
+    QueryAnnotations annotations;
+    annotations.canonical = canonical;
+    annotations.dedup = dedup;
+    annotations.symmetry = symmetry;
+    annotations.stats = stats.label_num != 0 ? &stats : nullptr;
+    annotations.graph = graph.vertex_num != 0 ? &graph : nullptr;
+    annotations.estimate_sample_num = estimate_sample_num;
+    annotations.seed = command.getSeed();
 
-    for (auto vertex : vertices) {
-    	for (ui i = 0; i < label_num; i++) {
-    		if (vertex.find(labels[i]) != std::string::npos){
-    			vertex_num_offset[i + 1]++;
-    			break;
-    		}
-    	}
+    if (sampling_mode) {
+        std::cout << "--------------------------------------------------------------------" << std::endl;
+        std::cout << "Sampling query graphs..." << std::endl;
+
+start = std::chrono::high_resolution_clock::now();
+
+        SamplerConfig config;
+        config.vertex_num = command.getSampleSize();
+        config.density = command.getSampleDensity();
+        config.method = command.getSampleMethod() == "bfs" ? SampleMethod::BreadthFirst : SampleMethod::RandomWalk;
+        config.max_per_label = command.getMaxPerLabel();
+        if (command.getSampleMethod() != "walk" && command.getSampleMethod() != "bfs") {
+            std::cout << "unknown sampling method " << command.getSampleMethod() << "! (use walk or bfs)" << std::endl;
+        }
+
+        std::string sample_labels = command.getSampleLabels();
+        if (!sample_labels.empty()) {
+            config.allowed_labels.assign(graph.label_num, 0);
+            std::istringstream label_stream(sample_labels);
+            std::string label;
+            while (std::getline(label_stream, label, ',')) {
+                LabelID i = 0;
+                if (profile.find(label, i) && i < graph.label_num) {
+                    config.allowed_labels[i] = 1;
+                } else {
+                    std::cout << "unknown label " << label << "!" << std::endl;
+                }
+            }
+        }
+
+        ui sample_num = command.getSampleNum();
+        uint64_t seed = command.getSeed();
+        ThreadPool pool(thread_num);
+
+        // each sample has its own seed, so the workload does not depend on the number of threads
+        std::vector<AnnotatedQuery> sampled_queries(sample_num);
+        std::vector<char> sampled(sample_num, 0);
+        pool.run(sample_num, [&](unsigned, unsigned i) {
+            ConvertedQuery query;
+            if (!sampleQuery(graph, config, seed + 0x9E3779B97F4A7C15ULL * (i + 1), query)) {
+                return;
+            }
+            annotateQuery(query, annotations, i, sampled_queries[i]);
+            sampled[i] = 1;
+        });
+        ui duplicate_num = dedup ? dropDuplicates(sampled_queries, sampled) : 0;
+
+        std::vector<std::string> names;
+        std::vector<std::string> files;
+        std::vector<AnnotatedQuery*> queries;
+        uint64_t sum_edge = 0;
+        for (ui i = 0; i < sample_num; i++) {
+            if (!sampled[i]) {
+                continue;
+            }
+            names.push_back("sample_" + std::to_string(i) + ".graph");
+            files.push_back(output_query_dir + "/" + names.back());
+            queries.push_back(&sampled_queries[i]);
+            sum_edge += sampled_queries[i].edge_num;
+        }
+        bool stored = storeQueries(output_pack_file, names, files, queries);
+
+        std::cout << "|Q|: " << names.size() << " / " << sample_num << " (threads: " << pool.getThreadNum() << ")" << std::endl;
+        if (dedup) {
+            std::cout << "Duplicates: " << duplicate_num << std::endl;
+        }
+        if (!names.empty()) {
+            std::cout << "avg |E(q)|: " << (double)sum_edge / names.size() << std::endl;
+        }
+        reportEstimates(output_report_file, names, queries);
+
+end = std::chrono::high_resolution_clock::now();
+double sample_query_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        std::cout << "--------------------------------------------------------------------" << std::endl;
+        printf("Load label profile time (seconds): %.4lf\n", NANOSECTOSEC(load_label_time_in_ns));
+        printf("Load data graph time (seconds): %.4lf\n", NANOSECTOSEC(load_graph_time_in_ns));
+        printf("Sample query graphs time (seconds): %.4lf\n", NANOSECTOSEC(sample_query_time_in_ns));
+        std::cout << "End." << std::endl;
+
+        return stored ? 0 : 1;
     }
 
-    for (ui i = 0; i < label_num; i++) {
-    	vertex_num_offset[i + 1] = vertex_num_offset[i + 1] + vertex_num_offset[i];
+    if (scale_mode) {
+        std::cout << "--------------------------------------------------------------------" << std::endl;
+        std::cout << "Scaling query graphs..." << std::endl;
+
+start = std::chrono::high_resolution_clock::now();
+
+        std::vector<ui> sizes;
+        std::istringstream size_stream(scale_sizes);
+        std::string size;
+        while (std::getline(size_stream, size, ',')) {
+            ui vertex_num = std::strtoul(size.c_str(), nullptr, 10);
+            if (vertex_num == 0) {
+                std::cout << "invalid query size " << size << "!" << std::endl;
+                continue;
+            }
+            sizes.push_back(vertex_num);
+        }
+
+        std::vector<QueryTask> seeds;
+        if (batch_mode) {
+            seeds = listQueryTasks(input_query_dir, input_manifest, output_query_dir);
+        } else {
+            QueryTask task;
+            task.input_file = input_query_graph_file;
+            task.name = baseName(input_query_graph_file);
+            seeds.push_back(task);
+        }
+        ThreadPool pool(thread_num);
+
+        std::vector<ConvertedQuery> seed_queries(seeds.size());
+        std::vector<char> converted(seeds.size(), 0);
+        pool.run(seeds.size(), [&](unsigned, unsigned i) {
+            converted[i] = convertQuery(profile, seeds[i].input_file, seed_queries[i]);
+        });
+
+        // variant t is seed t / (2 * |sizes|), size (t / 2) % |sizes|, dense if t is odd, with its own seed
+        ui variant_num = seeds.size() * sizes.size() * 2;
+        uint64_t seed = command.getSeed();
+        std::vector<AnnotatedQuery> scaled_queries(variant_num);
+        std::vector<char> scaled(variant_num, 0);
+        pool.run(variant_num, [&](unsigned, unsigned t) {
+            ui i = t / (2 * sizes.size());
+            if (!converted[i]) {
+                return;
+            }
+            ScaleConfig config;
+            config.vertex_num = sizes[(t / 2) % sizes.size()];
+            config.dense = t % 2 == 1;
+            ConvertedQuery query;
+            if (!scaleQuery(seed_queries[i], graph, config, seed + 0x9E3779B97F4A7C15ULL * (t + 1), query)) {
+                return;
+            }
+            annotateQuery(query, annotations, t, scaled_queries[t]);
+            scaled[t] = 1;
+        });
+        ui duplicate_num = dedup ? dropDuplicates(scaled_queries, scaled) : 0;
+
+        std::vector<std::string> names;
+        std::vector<std::string> files;
+        std::vector<AnnotatedQuery*> queries;
+        for (ui t = 0; t < variant_num; t++) {
+            if (!scaled[t]) {
+                continue;
+            }
+            const std::string &seed_name = seeds[t / (2 * sizes.size())].name;
+            std::string stem = seed_name.size() > 6 && seed_name.compare(seed_name.size() - 6, 6, ".graph") == 0
+                               ? seed_name.substr(0, seed_name.size() - 6) : seed_name;
+            names.push_back(stem + "_" + std::to_string(sizes[(t / 2) % sizes.size()]) + (t % 2 == 1 ? "_dense" : "_sparse") + ".graph");
+            files.push_back(output_query_dir + "/" + names.back());
+            queries.push_back(&scaled_queries[t]);
+        }
+        bool stored = storeQueries(output_pack_file, names, files, queries);
+
+        std::cout << "|Q|: " << names.size() << " / " << variant_num << " (threads: " << pool.getThreadNum() << ")" << std::endl;
+        if (dedup) {
+            std::cout << "Duplicates: " << duplicate_num << std::endl;
+        }
+        for (ui s = 0; s < sizes.size(); s++) {
+            uint64_t sum_edge[2] = {0, 0};
+            ui count[2] = {0, 0};
+            for (ui t = 2 * s; t < variant_num; t += 2 * sizes.size()) {
+                for (ui d = 0; d < 2; d++) {
+                    if (scaled[t + d]) {
+                        sum_edge[d] += scaled_queries[t + d].edge_num;
+                        count[d]++;
+                    }
+                }
+            }
+            std::cout << "|V(q)| = " << sizes[s] << ": avg |E(q)| sparse " << (count[0] == 0 ? 0 : (double)sum_edge[0] / count[0])
+                      << ", dense " << (count[1] == 0 ? 0 : (double)sum_edge[1] / count[1]) << std::endl;
+        }
+        reportEstimates(output_report_file, names, queries);
+
+end = std::chrono::high_resolution_clock::now();
+double scale_query_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        std::cout << "--------------------------------------------------------------------" << std::endl;
+        printf("Load label profile time (seconds): %.4lf\n", NANOSECTOSEC(load_label_time_in_ns));
+        printf("Load data graph time (seconds): %.4lf\n", NANOSECTOSEC(load_graph_time_in_ns));
+        printf("Scale query graphs time (seconds): %.4lf\n", NANOSECTOSEC(scale_query_time_in_ns));
+        std::cout << "End." << std::endl;
+
+        return stored ? 0 : 1;
     }
 
-    std::map<std::string, VertexID> vertices_newid;
-    for (auto vertex : vertices) {
-    	VertexID newid = 0;
-    	for (ui i = 0; i < label_num; i++) {
-    		if (vertex.find(labels[i]) != std::string::npos){
-    			newid = i;
-    			break;
-    		}
-    	}
-    	newid = vertex_num_offset[newid];
+    if (batch_mode) {
+        std::cout << "--------------------------------------------------------------------" << std::endl;
+        std::cout << "Converting query graphs..." << std::endl;
+
+start = std::chrono::high_resolution_clock::now();
+
+        std::vector<QueryTask> tasks = listQueryTasks(input_query_dir, input_manifest, output_query_dir);
+        if (output_pack_file.empty()) {
+            for (auto const& task : tasks) {
+                if (task.output_file.empty()) {
+                    std::cout << "no output for " << task.name << "! (-oqd, -pack or an output path in the manifest)" << std::endl;
+                    return 1;
+                }
+            }
+        }
+        ThreadPool pool(thread_num);
+
+        // queries are stored in task order once duplicates are known
+        std::vector<AnnotatedQuery> converted_queries(tasks.size());
+        std::vector<char> converted(tasks.size(), 0);
+        pool.run(tasks.size(), [&](unsigned, unsigned i) {
+            ConvertedQuery query;
+            if (!convertQuery(profile, tasks[i].input_file, query)) {
+                return;
+            }
+            annotateQuery(query, annotations, i, converted_queries[i]);
+            converted[i] = 1;
+        });
+        ui duplicate_num = dedup ? dropDuplicates(converted_queries, converted) : 0;
+
+        std::vector<std::string> names;
+        std::vector<std::string> files;
+        std::vector<AnnotatedQuery*> queries;
+        for (ui i = 0; i < tasks.size(); i++) {
+            if (converted[i]) {
+                names.push_back(tasks[i].name);
+                files.push_back(tasks[i].output_file);
+                queries.push_back(&converted_queries[i]);
+            }
+        }
+        bool stored = storeQueries(output_pack_file, names, files, queries);
+
+        std::cout << "|Q|: " << names.size() << " / " << tasks.size() << " (threads: " << pool.getThreadNum() << ")" << std::endl;
+        if (dedup) {
+            std::cout << "Duplicates: " << duplicate_num << std::endl;
+        }
+        reportEstimates(output_report_file, names, queries);
 
-    	std::string offset_string = vertex.substr(vertex.find("_") + 1, vertex.length() - vertex.find("_") - 1);
-    	ui offset_inlabel = std::stoul(offset_string) - 1;
-    	newid += offset_inlabel;
-    	vertices_newid.insert(std::make_pair(vertex, newid));
+end = std::chrono::high_resolution_clock::now();
+double convert_query_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        std::cout << "--------------------------------------------------------------------" << std::endl;
+        printf("Load label profile time (seconds): %.4lf\n", NANOSECTOSEC(load_label_time_in_ns));
+        if (!input_data_graph_file.empty()) {
+            printf("Load data graph time (seconds): %.4lf\n", NANOSECTOSEC(load_graph_time_in_ns));
+        }
+        printf("Convert query graphs time (seconds): %.4lf\n", NANOSECTOSEC(convert_query_time_in_ns));
+        std::cout << "End." << std::endl;
+
+        return stored ? 0 : 1;
     }
 
-    std::vector<std::set<VertexID> > in_neighbors;
-    std::vector<std::set<VertexID> > out_neighbors;
-    in_neighbors.resize(vertex_num);
-    out_neighbors.resize(vertex_num);
-    for (auto edge : edges) {
-    	VertexID src_newid = vertices_newid[edge.first];
-    	VertexID dest_newid = vertices_newid[edge.second];
+    std::cout << "--------------------------------------------------------------------" << std::endl;
+    std::cout << "Reading input query graph..." << std::endl;
 
-    	out_neighbors[src_newid].insert(dest_newid);
-        in_neighbors[dest_newid].insert(src_newid);
+start = std::chrono::high_resolution_clock::now();
+
+    ConvertedQuery query;
+    if (!convertQuery(profile, input_query_graph_file, query)) {
+        std::cout << "query graph is not converted!" << std::endl;
+        return 1;
     }
 
-    std::cout << "|V|: " << vertex_num << std::endl;
-    std::cout << "|E|: " << edge_num << std::endl;
+    std::cout << "|V|: " << query.vertex_num << std::endl;
+    std::cout << "|E|: " << query.edge_num << std::endl;
 
 end = std::chrono::high_resolution_clock::now();
 double load_query_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
@@ -158,59 +619,53 @@ double load_query_time_in_ns = std::chrono::duration_cast<std::chrono::nanosecon
 
 start = std::chrono::high_resolution_clock::now();
 
-    std::ofstream query_descriptor(output_query_graph_file, std::ios::binary);
-
-    query_descriptor.write((char*)&vertex_num, sizeof(ui));
-    query_descriptor.write((char*)&size_vertex_num_offset, sizeof(ui));
-    query_descriptor.write((char*)vertex_num_offset, sizeof(ui) * size_vertex_num_offset);
-
-    ui* in_degree = new ui[vertex_num];
-    ui* out_degree = new ui[vertex_num];
     ui sum_in_edge = 0;
     ui sum_out_edge = 0;
-    for (ui i = 0; i < vertex_num; i++) {
-        in_degree[i] = in_neighbors[i].size();
-        out_degree[i] = out_neighbors[i].size();
-        sum_in_edge += in_degree[i];
-        sum_out_edge += out_degree[i];
+    for (ui i = 0; i < query.vertex_num; i++) {
+        sum_in_edge += query.in_neighbors[i].size();
+        sum_out_edge += query.out_neighbors[i].size();
     }
     std::cout << "|E-|: " << sum_in_edge << std::endl;
     std::cout << "|E+|: " << sum_out_edge << std::endl;
 
-    VertexID** in_neighbors_array = new VertexID*[vertex_num];
-    VertexID** out_neighbors_array = new VertexID*[vertex_num];
-    for (ui i = 0; i < vertex_num; i++) {
-        in_neighbors_array[i] = new VertexID[in_degree[i]];
-        std::copy(in_neighbors[i].begin(), in_neighbors[i].end(), in_neighbors_array[i]);
-
-        out_neighbors_array[i] = new VertexID[out_degree[i]];
-        std::copy(out_neighbors[i].begin(), out_neighbors[i].end(), out_neighbors_array[i]);
+    AnnotatedQuery annotated;
+    annotateQuery(query, annotations, 0, annotated);
+    if (canonical) {
+        printf("Canonical hash: %016llx\n", (unsigned long long)annotated.hash);
     }
-    
-    query_descriptor.write((char*)in_degree, sizeof(ui) * vertex_num);
-    query_descriptor.write((char*)out_degree, sizeof(ui) * vertex_num);
-    for (ui i = 0; i < vertex_num; i++) {
-        query_descriptor.write((char*)in_neighbors_array[i], sizeof(VertexID) * in_degree[i]);
+    if (annotated.has_symmetry) {
+        std::cout << "Automorphisms: " << annotated.symmetry.automorphism_num << std::endl;
+        std::cout << "Symmetry-breaking constraints:";
+        for (auto const& constraint : annotated.symmetry.constraints) {
+            std::cout << " " << constraint.first << "<" << constraint.second;
+        }
+        std::cout << std::endl;
     }
-    for (ui i = 0; i < vertex_num; i++) {
-        query_descriptor.write((char*)out_neighbors_array[i], sizeof(VertexID) * out_degree[i]);
+    if (annotated.has_plan) {
+        std::cout << "Matching order:";
+        for (ui i = 0; i < annotated.plan.order.size(); i++) {
+            std::cout << " " << annotated.plan.order[i];
+        }
+        std::cout << std::endl;
+        std::cout << "Estimated embeddings (statistics): " << (annotated.plan.cardinality.empty() ? 0 : annotated.plan.cardinality.back()) << std::endl;
+    }
+    if (annotated.has_estimate) {
+        std::cout << "Estimated embeddings (sampling): " << annotated.estimate.sampled_estimate
+                  << " (relative error " << annotated.estimate.relative_error << ")" << std::endl;
     }
 
+    std::ofstream query_descriptor(output_query_graph_file, std::ios::binary);
+    query_descriptor.write(annotated.bytes.data(), annotated.bytes.size());
     query_descriptor.close();
+    if (query_descriptor.fail()) {
+        std::cout << "cannot write query file " << output_query_graph_file << "!" << std::endl;
+        return 1;
+    }
 
 end = std::chrono::high_resolution_clock::now();
 double store_query_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-	
+
 	std::cout << "--------------------------------------------------------------------" << std::endl;
-    delete[] vertex_num_offset;
-    delete[] in_degree;
-    delete[] out_degree;
-    for (VertexID i = 0; i < vertex_num; i++) {
-        delete[] in_neighbors_array[i];
-        delete[] out_neighbors_array[i];
-    }
-    delete[] label_offset;
-    delete[] labels_array;
 
     // print time info
     printf("Load label profile time (seconds): %.4lf\n", NANOSECTOSEC(load_label_time_in_ns));
@@ -219,4 +674,4 @@ double store_query_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseco
     std::cout << "End." << std::endl;
 
 	return 0;
-}
\ No newline at end of file
+}
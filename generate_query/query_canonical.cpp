@@ -0,0 +1,258 @@
+#include "query_canonical.h"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+
+static const int NO_JUMP = INT_MAX;
+
+// color[v] = rank of keys[v] among the distinct keys, returns the number of colours
+static ui rankKeys(const std::vector<std::vector<ui> > &keys, std::vector<ui> &color) {
+    ui n = keys.size();
+    std::vector<ui> index(n);
+    std::iota(index.begin(), index.end(), 0);
+    std::sort(index.begin(), index.end(), [&](ui a, ui b) { return keys[a] < keys[b]; });
+
+    ui rank = 0;
+    for (ui i = 0; i < n; i++) {
+        if (i > 0 && keys[index[i]] != keys[index[i - 1]]) {
+            rank++;
+        }
+        color[index[i]] = rank;
+    }
+    return n == 0 ? 0 : rank + 1;
+}
+
+// Split cells by the colours of in- and out-neighbors until the colouring is equitable
+static ui refine(const ConvertedQuery &query, std::vector<ui> &color, ui cell_num) {
+    ui n = query.vertex_num;
+    std::vector<std::vector<ui> > keys(n);
+    std::vector<ui> neighbor_colors;
+
+    while (true) {
+        for (ui v = 0; v < n; v++) {
+            std::vector<ui> &key = keys[v];
+            key.assign(1, color[v]);
+
+            neighbor_colors.clear();
+            for (VertexID w : query.out_neighbors[v]) {
+                neighbor_colors.push_back(color[w]);
+            }
+            std::sort(neighbor_colors.begin(), neighbor_colors.end());
+            key.insert(key.end(), neighbor_colors.begin(), neighbor_colors.end());
+            key.push_back(UINT_MAX);
+
+            neighbor_colors.clear();
+            for (VertexID w : query.in_neighbors[v]) {
+                neighbor_colors.push_back(color[w]);
+            }
+            std::sort(neighbor_colors.begin(), neighbor_colors.end());
+            key.insert(key.end(), neighbor_colors.begin(), neighbor_colors.end());
+        }
+
+        // keys start with the old colour, so cells only split and keep their order
+        ui new_cell_num = rankKeys(keys, color);
+        if (new_cell_num == cell_num) {
+            return cell_num;
+        }
+        cell_num = new_cell_num;
+    }
+}
+
+struct CanonicalSearch {
+    const ConvertedQuery &query;
+    ui n;
+    std::vector<ui> labels;
+
+    bool found_first;
+    std::vector<ui> first_code;
+    std::vector<ui> first_leaf;             // first_leaf[v] = position of v at the first leaf
+    std::vector<VertexID> first_path;
+    std::vector<ui> best_code;
+    std::vector<ui> best_leaf;
+
+    std::vector<VertexID> path;
+    std::vector<std::vector<VertexID> > generators;
+    std::vector<ui> generator_levels;       // generators[i] fixes the first generator_levels[i] vertices of the first path
+
+    explicit CanonicalSearch(const ConvertedQuery &q) : query(q), n(q.vertex_num), found_first(false) {}
+
+    void encode(const std::vector<ui> &leaf, std::vector<ui> &code) const {
+        std::vector<ui> label_at(n);
+        for (ui v = 0; v < n; v++) {
+            label_at[leaf[v]] = labels[v];
+        }
+
+        std::vector<std::pair<ui, ui> > edges;
+        for (ui v = 0; v < n; v++) {
+            for (VertexID w : query.out_neighbors[v]) {
+                edges.push_back(std::make_pair(leaf[v], leaf[w]));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        code.clear();
+        code.push_back(n);
+        code.insert(code.end(), label_at.begin(), label_at.end());
+        code.push_back(edges.size());
+        for (auto const& edge : edges) {
+            code.push_back(edge.first);
+            code.push_back(edge.second);
+        }
+    }
+
+    ui findRoot(std::vector<ui> &parent, ui v) const {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    // Orbits of the automorphisms found so far which fix the first depth vertices of the first path
+    void orbits(ui depth, std::vector<ui> &parent) {
+        parent.resize(n);
+        std::iota(parent.begin(), parent.end(), 0);
+        for (ui i = 0; i < generators.size(); i++) {
+            if (generator_levels[i] < depth) {
+                continue;
+            }
+            for (ui v = 0; v < n; v++) {
+                ui a = findRoot(parent, v);
+                ui b = findRoot(parent, generators[i][v]);
+                if (a != b) {
+                    parent[std::max(a, b)] = std::min(a, b);
+                }
+            }
+        }
+    }
+
+    // Returns the depth the search has to jump back to, or NO_JUMP
+    int search(const std::vector<ui> &color, ui cell_num, ui depth, bool on_first_path) {
+        if (cell_num == n) {
+            std::vector<ui> code;
+            encode(color, code);
+
+            if (!found_first) {
+                found_first = true;
+                first_code = code;
+                first_leaf = color;
+                first_path = path;
+                best_code = code;
+                best_leaf = color;
+                return NO_JUMP;
+            }
+
+            if (code == first_code) {
+                // the two leaves are related by an automorphism, its subtree mirrors the first path
+                std::vector<VertexID> vertex_at(n);
+                for (ui v = 0; v < n; v++) {
+                    vertex_at[first_leaf[v]] = v;
+                }
+                std::vector<VertexID> generator(n);
+                for (ui v = 0; v < n; v++) {
+                    generator[v] = vertex_at[color[v]];
+                }
+                ui level = 0;
+                while (level < path.size() && level < first_path.size() && path[level] == first_path[level]) {
+                    level++;
+                }
+                generators.push_back(generator);
+                generator_levels.push_back(level);
+                return level;
+            }
+
+            if (code < best_code) {
+                best_code = code;
+                best_leaf = color;
+            }
+            return NO_JUMP;
+        }
+
+        // branch on the smallest non-singleton cell
+        std::vector<ui> cell_size(cell_num, 0);
+        for (ui v = 0; v < n; v++) {
+            cell_size[color[v]]++;
+        }
+        ui target = cell_num;
+        for (ui c = 0; c < cell_num; c++) {
+            if (cell_size[c] > 1 && (target == cell_num || cell_size[c] < cell_size[target])) {
+                target = c;
+            }
+        }
+
+        std::vector<VertexID> tried;
+        std::vector<ui> parent;
+        std::vector<ui> child(n);
+        for (VertexID v = 0; v < n; v++) {
+            if (color[v] != target) {
+                continue;
+            }
+
+            if (on_first_path && !tried.empty()) {
+                orbits(depth, parent);
+                bool equivalent = false;
+                for (VertexID t : tried) {
+                    if (findRoot(parent, t) == findRoot(parent, v)) {
+                        equivalent = true;
+                        break;
+                    }
+                }
+                if (equivalent) {
+                    continue;
+                }
+            }
+
+            // individualize v: it becomes the first vertex of its cell
+            for (ui u = 0; u < n; u++) {
+                child[u] = color[u] + ((color[u] > target || (color[u] == target && u != v)) ? 1 : 0);
+            }
+            ui child_cell_num = refine(query, child, cell_num + 1);
+
+            path.push_back(v);
+            int jump = search(child, child_cell_num, depth + 1, on_first_path && tried.empty());
+            path.pop_back();
+            tried.push_back(v);
+
+            if (jump < (int)depth) {
+                return jump;
+            }
+        }
+        return NO_JUMP;
+    }
+};
+
+void canonicalForm(const ConvertedQuery &query, CanonicalForm &form) {
+    CanonicalSearch search(query);
+    ui n = query.vertex_num;
+
+    search.labels.resize(n);
+    for (ui v = 0; v < n; v++) {
+        search.labels[v] = std::upper_bound(query.vertex_num_offset.begin(), query.vertex_num_offset.end(), v)
+                           - query.vertex_num_offset.begin() - 1;
+    }
+
+    std::vector<std::vector<ui> > keys(n);
+    for (ui v = 0; v < n; v++) {
+        keys[v].assign(1, search.labels[v]);
+    }
+    std::vector<ui> color(n);
+    ui cell_num = rankKeys(keys, color);
+    cell_num = refine(query, color, cell_num);
+
+    search.search(color, cell_num, 0, true);
+
+    form.code.swap(search.best_code);
+    form.order.resize(n);
+    for (ui v = 0; v < n; v++) {
+        form.order[search.best_leaf[v]] = v;
+    }
+    form.generators.swap(search.generators);
+
+    form.hash = 14695981039346656037ULL;
+    for (ui value : form.code) {
+        for (ui i = 0; i < sizeof(ui); i++) {
+            form.hash ^= (value >> (8 * i)) & 0xff;
+            form.hash *= 1099511628211ULL;
+        }
+    }
+}
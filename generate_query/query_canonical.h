@@ -0,0 +1,35 @@
+#ifndef QUERY_CANONICAL_H
+#define QUERY_CANONICAL_H
+
+#include "type.h"
+#include "query_convert.h"
+#include <vector>
+
+/*
+ * Canonical form of a labeled directed query graph. Two queries have the same
+ * code if and only if they are isomorphic (preserving labels and directions).
+ *
+ * code:  vertex_num, label of each canonical position, edge_num,
+ *        then the (src, dest) canonical positions of every edge in sorted order
+ * order: order[i] is the query vertex placed at canonical position i. Labels
+ *        come first in the colouring, so positions stay grouped by label.
+ */
+struct CanonicalForm {
+    std::vector<ui> code;
+    std::vector<VertexID> order;
+    uint64_t hash;                                      // FNV-1a of code
+    std::vector<std::vector<VertexID> > generators;     // automorphisms met during the search, generator[u] = image of u
+
+    CanonicalForm() : hash(0) {}
+};
+
+/*
+ * Individualization-refinement search: colour refinement on (label, in/out
+ * neighbor colours), then branch on the smallest non-singleton cell and keep
+ * the smallest leaf code. Leaves equal to the first leaf are automorphisms;
+ * they prune the search by jumping back to the first path and by skipping
+ * children in the same orbit, as in nauty. Meant for query-sized graphs.
+ */
+void canonicalForm(const ConvertedQuery &query, CanonicalForm &form);
+
+#endif
@@ -5,6 +5,26 @@ QueryCommand::QueryCommand(const int argc, char **argv) : CommandParser(argc, ar
     options_key[OptionKeyword::IQueryGraphFile] = "-iq";
     options_key[OptionKeyword::OQueryGraphFile] = "-oq";
     options_key[OptionKeyword::LabelFile] = "-l";
+    options_key[OptionKeyword::IQueryDirectory] = "-iqd";
+    options_key[OptionKeyword::ManifestFile] = "-manifest";
+    options_key[OptionKeyword::OQueryDirectory] = "-oqd";
+    options_key[OptionKeyword::PackFile] = "-pack";
+    options_key[OptionKeyword::ThreadNum] = "-threads";
+    options_key[OptionKeyword::DataGraphFile] = "-dg";
+    options_key[OptionKeyword::SampleNum] = "-sample";
+    options_key[OptionKeyword::SampleSize] = "-sample_size";
+    options_key[OptionKeyword::SampleDensity] = "-density";
+    options_key[OptionKeyword::SamplingMethod] = "-method";
+    options_key[OptionKeyword::SampleLabels] = "-sample_labels";
+    options_key[OptionKeyword::MaxPerLabel] = "-max_per_label";
+    options_key[OptionKeyword::Seed] = "-seed";
+    options_key[OptionKeyword::Canonical] = "-canonical";
+    options_key[OptionKeyword::Dedup] = "-dedup";
+    options_key[OptionKeyword::StatsFile] = "-stats";
+    options_key[OptionKeyword::EstimateSampleNum] = "-estimate";
+    options_key[OptionKeyword::ReportFile] = "-report";
+    options_key[OptionKeyword::ScaleSizes] = "-scale";
+    options_key[OptionKeyword::Symmetry] = "-symmetry";
     processOptions();
 };
 
@@ -17,4 +37,64 @@ void QueryCommand::processOptions() {
 
     // Label file path
     options_value[OptionKeyword::LabelFile] = getCommandOption(options_key[OptionKeyword::LabelFile]);
+
+    // Input query graph directory
+    options_value[OptionKeyword::IQueryDirectory] = getCommandOption(options_key[OptionKeyword::IQueryDirectory]);
+
+    // Manifest of input query graphs
+    options_value[OptionKeyword::ManifestFile] = getCommandOption(options_key[OptionKeyword::ManifestFile]);
+
+    // Output query graph directory
+    options_value[OptionKeyword::OQueryDirectory] = getCommandOption(options_key[OptionKeyword::OQueryDirectory]);
+
+    // Packed output file
+    options_value[OptionKeyword::PackFile] = getCommandOption(options_key[OptionKeyword::PackFile]);
+
+    // Number of conversion threads
+    options_value[OptionKeyword::ThreadNum] = getCommandOption(options_key[OptionKeyword::ThreadNum]);
+
+    // Data graph to sample queries from
+    options_value[OptionKeyword::DataGraphFile] = getCommandOption(options_key[OptionKeyword::DataGraphFile]);
+
+    // Number of sampled queries
+    options_value[OptionKeyword::SampleNum] = getCommandOption(options_key[OptionKeyword::SampleNum]);
+
+    // Vertices per sampled query
+    options_value[OptionKeyword::SampleSize] = getCommandOption(options_key[OptionKeyword::SampleSize]);
+
+    // Density of sampled queries
+    options_value[OptionKeyword::SampleDensity] = getCommandOption(options_key[OptionKeyword::SampleDensity]);
+
+    // Sampling method
+    options_value[OptionKeyword::SamplingMethod] = getCommandOption(options_key[OptionKeyword::SamplingMethod]);
+
+    // Labels allowed in sampled queries
+    options_value[OptionKeyword::SampleLabels] = getCommandOption(options_key[OptionKeyword::SampleLabels]);
+
+    // Per-label vertex limit of sampled queries
+    options_value[OptionKeyword::MaxPerLabel] = getCommandOption(options_key[OptionKeyword::MaxPerLabel]);
+
+    // Sampler seed
+    options_value[OptionKeyword::Seed] = getCommandOption(options_key[OptionKeyword::Seed]);
+
+    // Canonical hash section
+    options_value[OptionKeyword::Canonical] = commandOptionExists(options_key[OptionKeyword::Canonical]) ? "true" : "false";
+
+    // Duplicate removal
+    options_value[OptionKeyword::Dedup] = commandOptionExists(options_key[OptionKeyword::Dedup]) ? "true" : "false";
+
+    // Statistics file of the data graph
+    options_value[OptionKeyword::StatsFile] = getCommandOption(options_key[OptionKeyword::StatsFile]);
+
+    // Random walks per query estimate
+    options_value[OptionKeyword::EstimateSampleNum] = getCommandOption(options_key[OptionKeyword::EstimateSampleNum]);
+
+    // Estimate report file
+    options_value[OptionKeyword::ReportFile] = getCommandOption(options_key[OptionKeyword::ReportFile]);
+
+    // Sizes of the scaled variants
+    options_value[OptionKeyword::ScaleSizes] = getCommandOption(options_key[OptionKeyword::ScaleSizes]);
+
+    // Symmetry-breaking section
+    options_value[OptionKeyword::Symmetry] = commandOptionExists(options_key[OptionKeyword::Symmetry]) ? "true" : "false";
 }
\ No newline at end of file
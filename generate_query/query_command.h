@@ -3,12 +3,33 @@
 
 #include "utility/command_parser.h"
 #include <map>
+#include <cstdlib>
 #include <iostream>
 
 enum OptionKeyword {
     LabelFile = 1,     // -l, The label file path, compulsive parameter
     IQueryGraphFile = 2,      // -iq, The query graph file path, compulsive parameter
-    OQueryGraphFile = 3      // -oq, The query graph file path, compulsive parameter
+    OQueryGraphFile = 3,      // -oq, The query graph file path, compulsive parameter
+    IQueryDirectory = 4,      // -iqd, Directory of input query graphs (*.graph), batch mode
+    ManifestFile = 5,      // -manifest, File listing "input [output]" query graph paths, batch mode
+    OQueryDirectory = 6,      // -oqd, Output directory of converted query graphs in batch mode
+    PackFile = 7,      // -pack, Write all queries of a batch into one indexed workload file instead
+    ThreadNum = 8,      // -threads, Number of conversion threads in batch mode (default: all cores)
+    DataGraphFile = 9,      // -dg, Converted data graph to sample queries from (sampling mode with -sample) or to estimate on
+    SampleNum = 10,      // -sample, Number of queries to sample
+    SampleSize = 11,      // -sample_size, Vertices per sampled query (default: 4)
+    SampleDensity = 12,      // -density, Share of the non-tree induced edges kept in [0, 1] (default: 1)
+    SamplingMethod = 13,      // -method, walk or bfs (default: walk)
+    SampleLabels = 14,      // -sample_labels, Comma separated labels a sampled query may contain (default: all)
+    MaxPerLabel = 15,      // -max_per_label, Maximum vertices of one label in a sampled query (default: no limit)
+    Seed = 16,      // -seed, Seed of the sampler (default: 0)
+    Canonical = 17,      // -canonical, Append the canonical hash section to every query
+    Dedup = 18,      // -dedup, Drop queries isomorphic to an earlier one (implies -canonical)
+    StatsFile = 19,      // -stats, Label-pair statistics of the data graph, appends a matching-order section to every query
+    EstimateSampleNum = 20,      // -estimate, Random walks per query for the embedding estimate (needs -dg, default: 0 = off)
+    ReportFile = 21,      // -report, Text report of the estimated embeddings of every query
+    ScaleSizes = 22,      // -scale, Comma separated vertex counts of the sparse and dense variants derived from the input queries (needs -dg)
+    Symmetry = 23      // -symmetry, Append the automorphism group order and symmetry-breaking constraints to every query
 };
 
 class QueryCommand : public CommandParser{
@@ -35,6 +56,89 @@ public:
     std::string getLabelFilePath() {
         return options_value[OptionKeyword::LabelFile];
     }
+
+    std::string getIQueryDirectory() {
+        return options_value[OptionKeyword::IQueryDirectory];
+    }
+
+    std::string getManifestFile() {
+        return options_value[OptionKeyword::ManifestFile];
+    }
+
+    std::string getOQueryDirectory() {
+        return options_value[OptionKeyword::OQueryDirectory];
+    }
+
+    std::string getPackFile() {
+        return options_value[OptionKeyword::PackFile];
+    }
+
+    unsigned getThreadNum() {
+        return std::strtoul(options_value[OptionKeyword::ThreadNum].c_str(), nullptr, 10);
+    }
+
+    std::string getDataGraphFile() {
+        return options_value[OptionKeyword::DataGraphFile];
+    }
+
+    unsigned getSampleNum() {
+        return std::strtoul(options_value[OptionKeyword::SampleNum].c_str(), nullptr, 10);
+    }
+
+    unsigned getSampleSize() {
+        std::string value = options_value[OptionKeyword::SampleSize];
+        return value.empty() ? 4 : std::strtoul(value.c_str(), nullptr, 10);
+    }
+
+    double getSampleDensity() {
+        std::string value = options_value[OptionKeyword::SampleDensity];
+        return value.empty() ? 1.0 : std::strtod(value.c_str(), nullptr);
+    }
+
+    std::string getSampleMethod() {
+        std::string value = options_value[OptionKeyword::SamplingMethod];
+        return value.empty() ? "walk" : value;
+    }
+
+    std::string getSampleLabels() {
+        return options_value[OptionKeyword::SampleLabels];
+    }
+
+    unsigned getMaxPerLabel() {
+        return std::strtoul(options_value[OptionKeyword::MaxPerLabel].c_str(), nullptr, 10);
+    }
+
+    unsigned long long getSeed() {
+        return std::strtoull(options_value[OptionKeyword::Seed].c_str(), nullptr, 10);
+    }
+
+    bool getCanonicalHash() {
+        return options_value[OptionKeyword::Canonical] == "true";
+    }
+
+    bool getDedup() {
+        return options_value[OptionKeyword::Dedup] == "true";
+    }
+
+    std::string getStatsFile() {
+        return options_value[OptionKeyword::StatsFile];
+    }
+
+    unsigned getEstimateSampleNum() {
+        return std::strtoul(options_value[OptionKeyword::EstimateSampleNum].c_str(), nullptr, 10);
+    }
+
+    std::string getReportFile() {
+        return options_value[OptionKeyword::ReportFile];
+    }
+
+    std::string getScaleSizes() {
+        return options_value[OptionKeyword::ScaleSizes];
+    }
+
+    bool getSymmetry() {
+        return options_value[OptionKeyword::Symmetry] == "true";
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "query_convert.h"
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+#include <set>
+
+bool LabelProfile::load(const std::string &file) {
+    std::ifstream label_descriptor(file, std::ios::binary);
+
+    if (!label_descriptor.is_open()) {
+        std::cout << "wrong path! (label file)" << std::endl;
+        return false;
+    }
+
+    label_descriptor.read((char*)&label_num, sizeof(VertexID));
+
+    std::vector<VertexID> label_offset(label_num + 1);
+    label_descriptor.read((char*)label_offset.data(), sizeof(VertexID) * (label_num + 1));
+
+    std::string labels_string(label_offset[label_num], '\0');
+    label_descriptor.read(&labels_string[0], sizeof(char) * label_offset[label_num]);
+
+    labels.clear();
+    label_index.clear();
+    for (VertexID i = 0; i < label_num; i++) {
+        std::string label = labels_string.substr(label_offset[i], label_offset[i + 1] - label_offset[i]);
+        label_index.insert(std::make_pair(label, i));
+
+        if (label.find("_") != std::string::npos) {
+            label = label.substr(label.find("_") + 1, label.length() - label.find("_") - 1);
+        }
+        labels.push_back(label);
+    }
+    // short names resolve to their label unless two labels share one
+    for (VertexID i = 0; i < label_num; i++) {
+        if (!label_index.insert(std::make_pair(labels[i], i)).second && label_index[labels[i]] != i) {
+            std::cout << "ambiguous label name " << labels[i] << "! (use the full name)" << std::endl;
+        }
+    }
+    return true;
+}
+
+bool convertQuery(const LabelProfile &profile, const std::string &file, ConvertedQuery &query) {
+    std::ifstream query_descriptor(file);
+
+    if (!query_descriptor.is_open()) {
+        std::cout << "wrong path! (query file " << file << ")" << std::endl;
+        return false;
+    }
+
+    ui edge_num = 0;
+    std::vector<std::pair<ui, ui> > edges;
+
+    // every distinct vertex name is parsed once into its label and its number within the label
+    std::unordered_map<std::string, ui> vertex_index;
+    std::vector<LabelID> vertex_label;
+    std::vector<ui> vertex_rank;
+
+    query_descriptor >> edge_num;
+
+    for (ui i = 0; i < edge_num; i++) {
+        std::string names[2];
+        ui endpoints[2];
+
+        query_descriptor >> names[0] >> names[1];
+
+        for (ui j = 0; j < 2; j++) {
+            auto inserted = vertex_index.insert(std::make_pair(names[j], (ui)vertex_label.size()));
+            endpoints[j] = inserted.first->second;
+            if (!inserted.second) {
+                continue;
+            }
+
+            const std::string &vertex = names[j];
+            size_t split = vertex.rfind('_');
+            LabelID label = 0;
+            char* rank_end = nullptr;
+            unsigned long rank = split == std::string::npos ? 0 : std::strtoul(vertex.c_str() + split + 1, &rank_end, 10);
+            if (split == std::string::npos || !profile.find(vertex.substr(0, split), label) || *rank_end != '\0' || rank == 0) {
+                std::cout << "wrong vertex name " << vertex << "! (query file " << file << ")" << std::endl;
+                return false;
+            }
+            vertex_label.push_back(label);
+            vertex_rank.push_back(rank - 1);
+        }
+
+        edges.push_back(std::make_pair(endpoints[0], endpoints[1]));
+    }
+
+    ui label_num = profile.label_num;
+    ui vertex_num = vertex_label.size();
+    std::vector<ui> vertex_num_offset(label_num + 1, 0);
+
+    for (ui i = 0; i < vertex_num; i++) {
+        vertex_num_offset[vertex_label[i] + 1]++;
+    }
+
+    for (ui i = 0; i < label_num; i++) {
+        vertex_num_offset[i + 1] = vertex_num_offset[i + 1] + vertex_num_offset[i];
+    }
+
+    std::vector<VertexID> vertices_newid(vertex_num);
+    for (auto const& vertex : vertex_index) {
+        ui i = vertex.second;
+        VertexID newid = vertex_num_offset[vertex_label[i]] + vertex_rank[i];
+        if (newid >= vertex_num_offset[vertex_label[i] + 1]) {
+            std::cout << "wrong vertex name " << vertex.first << "! (query file " << file << ")" << std::endl;
+            return false;
+        }
+        vertices_newid[i] = newid;
+    }
+
+    std::vector<std::set<VertexID> > in_neighbors(vertex_num);
+    std::vector<std::set<VertexID> > out_neighbors(vertex_num);
+    for (auto const& edge : edges) {
+        VertexID src_newid = vertices_newid[edge.first];
+        VertexID dest_newid = vertices_newid[edge.second];
+
+        out_neighbors[src_newid].insert(dest_newid);
+        in_neighbors[dest_newid].insert(src_newid);
+    }
+
+    query.vertex_num = vertex_num;
+    query.edge_num = edge_num;
+    query.vertex_num_offset = vertex_num_offset;
+    query.in_neighbors.resize(vertex_num);
+    query.out_neighbors.resize(vertex_num);
+    for (ui i = 0; i < vertex_num; i++) {
+        query.in_neighbors[i].assign(in_neighbors[i].begin(), in_neighbors[i].end());
+        query.out_neighbors[i].assign(out_neighbors[i].begin(), out_neighbors[i].end());
+    }
+    return true;
+}
+
+void writeQuery(std::ostream &descriptor, const ConvertedQuery &query) {
+    ui vertex_num = query.vertex_num;
+    ui size_vertex_num_offset = query.vertex_num_offset.size();
+    descriptor.write((char*)&vertex_num, sizeof(ui));
+    descriptor.write((char*)&size_vertex_num_offset, sizeof(ui));
+    descriptor.write((char*)query.vertex_num_offset.data(), sizeof(ui) * size_vertex_num_offset);
+
+    std::vector<ui> in_degree(vertex_num);
+    std::vector<ui> out_degree(vertex_num);
+    for (ui i = 0; i < vertex_num; i++) {
+        in_degree[i] = query.in_neighbors[i].size();
+        out_degree[i] = query.out_neighbors[i].size();
+    }
+
+    descriptor.write((char*)in_degree.data(), sizeof(ui) * vertex_num);
+    descriptor.write((char*)out_degree.data(), sizeof(ui) * vertex_num);
+    for (ui i = 0; i < vertex_num; i++) {
+        descriptor.write((char*)query.in_neighbors[i].data(), sizeof(VertexID) * in_degree[i]);
+    }
+    for (ui i = 0; i < vertex_num; i++) {
+        descriptor.write((char*)query.out_neighbors[i].data(), sizeof(VertexID) * out_degree[i]);
+    }
+}
+
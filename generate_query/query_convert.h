@@ -0,0 +1,52 @@
+#ifndef QUERY_CONVERT_H
+#define QUERY_CONVERT_H
+
+#include "type.h"
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Labels of the data graph, loaded once and shared by every query conversion
+struct LabelProfile {
+    ui label_num;
+    std::vector<std::string> labels;        // label names without their overall prefix, e.g. "city"
+    std::unordered_map<std::string, LabelID> label_index;      // short and full names, e.g. "city" and "place_city"
+
+    LabelProfile() : label_num(0) {}
+
+    bool load(const std::string &file);
+
+    // Exact match of a label name
+    bool find(const std::string &name, LabelID &label) const {
+        auto it = label_index.find(name);
+        if (it == label_index.end()) {
+            return false;
+        }
+        label = it->second;
+        return true;
+    }
+};
+
+/*
+ * A query in the data graph layout: vertices are grouped by label, and the
+ * vertex named <label>_<k> gets ID vertex_num_offset[label] + k - 1. The
+ * label is the part before the last '_' and has to match a label exactly.
+ */
+struct ConvertedQuery {
+    ui vertex_num;
+    ui edge_num;
+    std::vector<ui> vertex_num_offset;
+    std::vector<std::vector<VertexID> > in_neighbors;      // sorted
+    std::vector<std::vector<VertexID> > out_neighbors;     // sorted
+
+    ConvertedQuery() : vertex_num(0), edge_num(0) {}
+};
+
+// Parse a text query (edge count, then one "src dest" pair per line)
+bool convertQuery(const LabelProfile &profile, const std::string &file, ConvertedQuery &query);
+
+void writeQuery(std::ostream &descriptor, const ConvertedQuery &query);
+
+#endif
@@ -0,0 +1,157 @@
+#include "query_estimate.h"
+#include "query_graph.h"
+#include "query_section.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+void connectedOrder(const ConvertedQuery &query, const DataGraph &graph, MatchingPlan &plan) {
+    ui n = query.vertex_num;
+    plan.order.clear();
+    plan.pivot.clear();
+    plan.cardinality.clear();
+
+    std::vector<char> matched(n, 0);
+    std::vector<ui> backward(n, 0);
+    for (ui i = 0; i < n; i++) {
+        VertexID next = n;
+        ui next_label_size = 0;
+        for (VertexID u = 0; u < n; u++) {
+            if (matched[u]) {
+                continue;
+            }
+            LabelID label = std::upper_bound(query.vertex_num_offset.begin(), query.vertex_num_offset.end(), u)
+                            - query.vertex_num_offset.begin() - 1;
+            ui label_size = graph.vertex_num_offset[label + 1] - graph.vertex_num_offset[label];
+            if (next == n || backward[u] > backward[next] || (backward[u] == backward[next] && label_size < next_label_size)) {
+                next = u;
+                next_label_size = label_size;
+            }
+        }
+
+        VertexID pivot = NO_PIVOT;
+        for (VertexID w : query.in_neighbors[next]) {
+            if (matched[w] && pivot == NO_PIVOT) {
+                pivot = w;
+            }
+        }
+        for (VertexID w : query.out_neighbors[next]) {
+            if (matched[w] && pivot == NO_PIVOT) {
+                pivot = w;
+            }
+        }
+
+        matched[next] = 1;
+        for (VertexID w : query.out_neighbors[next]) {
+            backward[w]++;
+        }
+        for (VertexID w : query.in_neighbors[next]) {
+            backward[w]++;
+        }
+        plan.order.push_back(next);
+        plan.pivot.push_back(pivot);
+    }
+}
+
+void estimateBySampling(const ConvertedQuery &query, const DataGraph &graph, const MatchingPlan &plan,
+                        ui sample_num, uint64_t seed, EmbeddingEstimate &estimate) {
+    ui n = query.vertex_num;
+    std::vector<LabelID> labels(n);
+    for (VertexID u = 0; u < n; u++) {
+        labels[u] = std::upper_bound(query.vertex_num_offset.begin(), query.vertex_num_offset.end(), u)
+                    - query.vertex_num_offset.begin() - 1;
+    }
+
+    // queries of up to 64 vertices check their backward edges through adjacency masks
+    QueryGraph bitset_query;
+    bool small = bitset_query.build(n, query.vertex_num_offset, query.in_neighbors, query.out_neighbors);
+
+    std::mt19937_64 rng(seed);
+    std::vector<VertexID> embedding(n);
+    std::vector<char> matched(n, 0);
+    double sum = 0;
+    double square_sum = 0;
+
+    for (ui sample = 0; sample < sample_num; sample++) {
+        std::fill(matched.begin(), matched.end(), 0);
+        uint64_t matched_mask = 0;
+        double weight = 1;
+
+        for (ui i = 0; i < n && weight != 0; i++) {
+            VertexID u = plan.order[i];
+            VertexID label_begin = graph.vertex_num_offset[labels[u]];
+            VertexID label_end = graph.vertex_num_offset[labels[u] + 1];
+
+            // the choices for u: its label's vertices, or the pivot's neighbors of that label
+            const VertexID* choices = nullptr;
+            uint64_t choice_num = 0;
+            VertexID p = plan.pivot[i];
+            if (p == NO_PIVOT) {
+                choice_num = label_end - label_begin;
+            } else {
+                bool outgoing = std::binary_search(query.out_neighbors[p].begin(), query.out_neighbors[p].end(), u);
+                const VertexID* neighbors = outgoing ? graph.getOutNeighbors(embedding[p]) : graph.getInNeighbors(embedding[p]);
+                ui degree = outgoing ? graph.getOutDegree(embedding[p]) : graph.getInDegree(embedding[p]);
+                choices = std::lower_bound(neighbors, neighbors + degree, label_begin);
+                choice_num = std::lower_bound(choices, neighbors + degree, label_end) - choices;
+            }
+            if (choice_num == 0) {
+                weight = 0;
+                break;
+            }
+            uint64_t pick = rng() % choice_num;
+            VertexID v = choices == nullptr ? label_begin + pick : choices[pick];
+
+            bool valid = true;
+            for (ui j = 0; j < i && valid; j++) {
+                valid = embedding[plan.order[j]] != v;
+            }
+            if (small) {
+                for (uint64_t bits = bitset_query.getOutMask(u) & matched_mask; bits != 0 && valid; bits &= bits - 1) {
+                    valid = graph.hasEdge(v, embedding[__builtin_ctzll(bits)]);
+                }
+                for (uint64_t bits = bitset_query.getInMask(u) & matched_mask; bits != 0 && valid; bits &= bits - 1) {
+                    valid = graph.hasEdge(embedding[__builtin_ctzll(bits)], v);
+                }
+                valid = valid && (!bitset_query.hasEdge(u, u) || graph.hasEdge(v, v));
+            } else {
+                for (VertexID w : query.out_neighbors[u]) {
+                    valid = valid && (w == u ? graph.hasEdge(v, v) : (!matched[w] || graph.hasEdge(v, embedding[w])));
+                }
+                for (VertexID w : query.in_neighbors[u]) {
+                    valid = valid && (!matched[w] || graph.hasEdge(embedding[w], v));
+                }
+            }
+            if (!valid) {
+                weight = 0;
+                break;
+            }
+
+            embedding[u] = v;
+            matched[u] = 1;
+            if (small) {
+                matched_mask |= 1ULL << u;
+            }
+            weight *= choice_num;
+        }
+
+        sum += weight;
+        square_sum += weight * weight;
+    }
+
+    estimate.sample_num = sample_num;
+    estimate.sampled_estimate = sample_num == 0 ? 0 : sum / sample_num;
+    estimate.relative_error = 0;
+    if (sample_num > 1 && sum > 0) {
+        double mean = sum / sample_num;
+        double variance = std::max(0.0, (square_sum - sample_num * mean * mean) / (sample_num - 1));
+        estimate.relative_error = std::sqrt(variance / sample_num) / mean;
+    }
+}
+
+void writeCardinalityEstimate(std::ostream &descriptor, const EmbeddingEstimate &estimate) {
+    writeQuerySectionHeader(descriptor, QuerySection::CardinalityEstimate, sizeof(ui) + sizeof(double) * 2);
+    descriptor.write((char*)&estimate.sample_num, sizeof(ui));
+    descriptor.write((char*)&estimate.sampled_estimate, sizeof(double));
+    descriptor.write((char*)&estimate.stats_estimate, sizeof(double));
+}
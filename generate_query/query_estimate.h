@@ -0,0 +1,47 @@
+#ifndef QUERY_ESTIMATE_H
+#define QUERY_ESTIMATE_H
+
+#include "type.h"
+#include "data_graph.h"
+#include "query_convert.h"
+#include "query_plan.h"
+#include <ostream>
+#include <vector>
+
+/*
+ * Embedding-count estimate of a query.
+ *
+ * Cardinality-estimate section payload (QuerySection::CardinalityEstimate):
+ *   ui sample_num, double sampled_estimate, double stats_estimate
+ * An estimate is negative if it was not computed (no data graph or no statistics).
+ */
+struct EmbeddingEstimate {
+    ui sample_num;
+    double sampled_estimate;
+    double stats_estimate;
+    double relative_error;                  // standard error of sampled_estimate over sampled_estimate
+
+    EmbeddingEstimate() : sample_num(0), sampled_estimate(-1), stats_estimate(-1), relative_error(0) {}
+};
+
+/*
+ * Matching order for sampling when no plan is available: start at the vertex
+ * whose label has the fewest data vertices, then always take the frontier
+ * vertex with the most edges back into the matched ones (RI style).
+ */
+void connectedOrder(const ConvertedQuery &query, const DataGraph &graph, MatchingPlan &plan);
+
+/*
+ * Random-walk estimate (WanderJoin) of the number of embeddings. Each walk
+ * follows the plan: a vertex with a pivot is drawn uniformly from the
+ * pivot's neighbors of its label, found as one run of the sorted neighbor
+ * list, a vertex without one uniformly from its label. A walk which hits
+ * an injectivity or edge violation counts 0, a complete one counts the
+ * product of the choice counts, and the mean over the walks is unbiased.
+ */
+void estimateBySampling(const ConvertedQuery &query, const DataGraph &graph, const MatchingPlan &plan,
+                        ui sample_num, uint64_t seed, EmbeddingEstimate &estimate);
+
+void writeCardinalityEstimate(std::ostream &descriptor, const EmbeddingEstimate &estimate);
+
+#endif
@@ -0,0 +1,245 @@
+#ifndef QUERY_GRAPH_H
+#define QUERY_GRAPH_H
+
+#include "type.h"
+#include "query_section.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#define MAX_QUERY_VERTEX_NUM 64
+
+/*
+ * Compact query graph for up to MAX_QUERY_VERTEX_NUM vertices. Bit v of
+ * in_mask[u] / out_mask[u] is set if v -> u / u -> v is an edge, so a test
+ * such as "is u adjacent to a matched vertex" is one AND with the mask of
+ * matched vertices. Labels follow the query layout (vertices grouped by
+ * label), degrees and neighbor-label frequencies (NLF) are precomputed.
+ * Symmetry-breaking constraints, if the file has them, are kept as masks:
+ * bit v of lower_mask[u] means an embedding f needs f(v) < f(u).
+ *
+ * Header-only, so matchers can include it and load the files written by
+ * QueryGenerator with load() without linking the generator.
+ */
+class QueryGraph {
+private:
+    ui vertex_num;
+    ui label_num;
+    ui edge_num;
+    std::vector<ui> vertex_num_offset;
+    LabelID labels[MAX_QUERY_VERTEX_NUM];
+    uint64_t in_mask[MAX_QUERY_VERTEX_NUM];
+    uint64_t out_mask[MAX_QUERY_VERTEX_NUM];
+    ui in_degree[MAX_QUERY_VERTEX_NUM];
+    ui out_degree[MAX_QUERY_VERTEX_NUM];
+    std::vector<ui> in_nlf;                 // in_nlf[u * label_num + l] in-neighbors of u with label l
+    std::vector<ui> out_nlf;
+    uint64_t lower_mask[MAX_QUERY_VERTEX_NUM];
+    uint64_t upper_mask[MAX_QUERY_VERTEX_NUM];
+    double automorphism_num;
+
+public:
+    QueryGraph() : vertex_num(0), label_num(0), edge_num(0), automorphism_num(1) {}
+
+    // From sorted neighbor lists in the query layout, false if the query has too many vertices
+    bool build(ui n, const std::vector<ui> &offsets, const std::vector<std::vector<VertexID> > &in_neighbors,
+               const std::vector<std::vector<VertexID> > &out_neighbors) {
+        if (n > MAX_QUERY_VERTEX_NUM || offsets.empty()) {
+            return false;
+        }
+        vertex_num = n;
+        label_num = offsets.size() - 1;
+        vertex_num_offset = offsets;
+        edge_num = 0;
+        for (ui u = 0; u < n; u++) {
+            in_mask[u] = 0;
+            out_mask[u] = 0;
+            for (VertexID v : in_neighbors[u]) {
+                in_mask[u] |= 1ULL << v;
+            }
+            for (VertexID v : out_neighbors[u]) {
+                out_mask[u] |= 1ULL << v;
+            }
+            in_degree[u] = in_neighbors[u].size();
+            out_degree[u] = out_neighbors[u].size();
+            edge_num += out_degree[u];
+        }
+        finish();
+        return true;
+    }
+
+    // From the bytes of a query graph file, of its optional sections only the symmetry-breaking one is read
+    bool load(const char* data, uint64_t size) {
+        const char* end = data + size;
+        ui n = 0;
+        ui size_vertex_num_offset = 0;
+        if (size < sizeof(ui) * 2) {
+            return false;
+        }
+        std::memcpy(&n, data, sizeof(ui));
+        std::memcpy(&size_vertex_num_offset, data + sizeof(ui), sizeof(ui));
+        data += sizeof(ui) * 2;
+        if (n > MAX_QUERY_VERTEX_NUM || size_vertex_num_offset == 0
+            || (uint64_t)(end - data) < sizeof(ui) * ((uint64_t)size_vertex_num_offset + 2 * n)) {
+            return false;
+        }
+
+        vertex_num = n;
+        label_num = size_vertex_num_offset - 1;
+        vertex_num_offset.resize(size_vertex_num_offset);
+        std::memcpy(vertex_num_offset.data(), data, sizeof(ui) * size_vertex_num_offset);
+        data += sizeof(ui) * size_vertex_num_offset;
+        if (vertex_num_offset[0] != 0 || vertex_num_offset[label_num] != n
+            || !std::is_sorted(vertex_num_offset.begin(), vertex_num_offset.end())) {
+            return false;
+        }
+        std::memcpy(in_degree, data, sizeof(ui) * n);
+        std::memcpy(out_degree, data + sizeof(ui) * n, sizeof(ui) * n);
+        data += sizeof(ui) * 2 * n;
+
+        uint64_t list_size = 0;
+        for (ui u = 0; u < n; u++) {
+            list_size += in_degree[u] + out_degree[u];
+        }
+        if ((uint64_t)(end - data) < sizeof(VertexID) * list_size) {
+            return false;
+        }
+
+        edge_num = 0;
+        for (ui u = 0; u < n; u++) {
+            in_mask[u] = 0;
+            for (ui i = 0; i < in_degree[u]; i++, data += sizeof(VertexID)) {
+                VertexID v;
+                std::memcpy(&v, data, sizeof(VertexID));
+                if (v >= n) {
+                    return false;
+                }
+                in_mask[u] |= 1ULL << v;
+            }
+        }
+        for (ui u = 0; u < n; u++) {
+            out_mask[u] = 0;
+            for (ui i = 0; i < out_degree[u]; i++, data += sizeof(VertexID)) {
+                VertexID v;
+                std::memcpy(&v, data, sizeof(VertexID));
+                if (v >= n) {
+                    return false;
+                }
+                out_mask[u] |= 1ULL << v;
+            }
+            edge_num += out_degree[u];
+        }
+        finish();
+
+        while ((uint64_t)(end - data) >= sizeof(ui) + sizeof(uint64_t)) {
+            ui tag = 0;
+            uint64_t section_size = 0;
+            std::memcpy(&tag, data, sizeof(ui));
+            std::memcpy(&section_size, data + sizeof(ui), sizeof(uint64_t));
+            data += sizeof(ui) + sizeof(uint64_t);
+            if ((uint64_t)(end - data) < section_size) {
+                return false;
+            }
+            if (tag == QuerySection::SymmetryConstraints && !loadConstraints(data, section_size)) {
+                return false;
+            }
+            data += section_size;
+        }
+        return true;
+    }
+
+    bool load(const std::string &file) {
+        std::ifstream descriptor(file, std::ios::binary);
+        if (!descriptor.is_open()) {
+            return false;
+        }
+        std::vector<char> bytes((std::istreambuf_iterator<char>(descriptor)), std::istreambuf_iterator<char>());
+        return load(bytes.data(), bytes.size());
+    }
+
+    ui getVertexNum() const { return vertex_num; }
+    ui getLabelNum() const { return label_num; }
+    ui getEdgeNum() const { return edge_num; }
+    LabelID getLabel(VertexID u) const { return labels[u]; }
+    ui getInDegree(VertexID u) const { return in_degree[u]; }
+    ui getOutDegree(VertexID u) const { return out_degree[u]; }
+    uint64_t getInMask(VertexID u) const { return in_mask[u]; }
+    uint64_t getOutMask(VertexID u) const { return out_mask[u]; }
+    uint64_t getNeighborMask(VertexID u) const { return in_mask[u] | out_mask[u]; }
+    ui getInNLF(VertexID u, LabelID l) const { return in_nlf[u * label_num + l]; }
+    ui getOutNLF(VertexID u, LabelID l) const { return out_nlf[u * label_num + l]; }
+
+    // u -> v
+    bool hasEdge(VertexID u, VertexID v) const { return (out_mask[u] >> v) & 1; }
+
+    uint64_t getLabelMask(LabelID l) const {
+        ui begin = vertex_num_offset[l];
+        ui end = vertex_num_offset[l + 1];
+        uint64_t below_end = end == 64 ? ~0ULL : (1ULL << end) - 1;
+        uint64_t below_begin = begin == 64 ? ~0ULL : (1ULL << begin) - 1;
+        return below_end & ~below_begin;
+    }
+
+    // Vertices with an edge to or from a vertex of mask
+    bool isAdjacentTo(VertexID u, uint64_t mask) const { return (getNeighborMask(u) & mask) != 0; }
+
+    // Symmetry breaking: the vertices whose data vertex has to be smaller / larger than the one of u
+    uint64_t getLowerMask(VertexID u) const { return lower_mask[u]; }
+    uint64_t getUpperMask(VertexID u) const { return upper_mask[u]; }
+
+    // 1 if the file has no symmetry-breaking section
+    double getAutomorphismNum() const { return automorphism_num; }
+
+private:
+    bool loadConstraints(const char* data, uint64_t size) {
+        ui constraint_num = 0;
+        if (size < sizeof(double) + sizeof(ui)) {
+            return false;
+        }
+        std::memcpy(&automorphism_num, data, sizeof(double));
+        std::memcpy(&constraint_num, data + sizeof(double), sizeof(ui));
+        data += sizeof(double) + sizeof(ui);
+        if (size - sizeof(double) - sizeof(ui) < sizeof(VertexID) * 2 * (uint64_t)constraint_num) {
+            return false;
+        }
+        for (ui i = 0; i < constraint_num; i++, data += sizeof(VertexID) * 2) {
+            VertexID u, v;
+            std::memcpy(&u, data, sizeof(VertexID));
+            std::memcpy(&v, data + sizeof(VertexID), sizeof(VertexID));
+            if (u >= vertex_num || v >= vertex_num) {
+                return false;
+            }
+            upper_mask[u] |= 1ULL << v;
+            lower_mask[v] |= 1ULL << u;
+        }
+        return true;
+    }
+
+    void finish() {
+        in_nlf.assign(vertex_num * label_num, 0);
+        out_nlf.assign(vertex_num * label_num, 0);
+        std::fill(lower_mask, lower_mask + vertex_num, 0);
+        std::fill(upper_mask, upper_mask + vertex_num, 0);
+        automorphism_num = 1;
+        LabelID label = 0;
+        for (ui u = 0; u < vertex_num; u++) {
+            while (u >= vertex_num_offset[label + 1]) {
+                label++;
+            }
+            labels[u] = label;
+        }
+        for (ui u = 0; u < vertex_num; u++) {
+            for (uint64_t bits = in_mask[u]; bits != 0; bits &= bits - 1) {
+                in_nlf[u * label_num + labels[__builtin_ctzll(bits)]]++;
+            }
+            for (uint64_t bits = out_mask[u]; bits != 0; bits &= bits - 1) {
+                out_nlf[u * label_num + labels[__builtin_ctzll(bits)]]++;
+            }
+        }
+    }
+};
+
+#endif
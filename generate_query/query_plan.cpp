@@ -0,0 +1,149 @@
+#include "query_plan.h"
+#include "query_section.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+
+// Label vertices passing the neighbor-label degree filters of u, assuming independent filters
+static double candidateCount(const ConvertedQuery &query, const GraphStats &stats, const std::vector<LabelID> &labels, VertexID u) {
+    LabelID label = labels[u];
+    double count = stats.vertex_count[label];
+    if (count == 0) {
+        return 0;
+    }
+
+    std::map<LabelID, ui> out_labels;
+    std::map<LabelID, ui> in_labels;
+    for (VertexID w : query.out_neighbors[u]) {
+        out_labels[labels[w]]++;
+    }
+    for (VertexID w : query.in_neighbors[u]) {
+        in_labels[labels[w]]++;
+    }
+
+    double label_count = count;
+    for (auto const& group : out_labels) {
+        count *= countDegreeAtLeast(stats.getPair(label, group.first).out_degree_histogram, group.second) / label_count;
+    }
+    for (auto const& group : in_labels) {
+        count *= countDegreeAtLeast(stats.getPair(group.first, label).in_degree_histogram, group.second) / label_count;
+    }
+    return count;
+}
+
+// Probability that a given vertex pair of labels (a, b), both with such edges, is connected a -> b
+static double edgeSelectivity(const LabelPairStats &pair) {
+    if (pair.edge_num == 0) {
+        return 0;
+    }
+    return std::min(1.0, (double)pair.edge_num / ((double)pair.distinct_src * pair.distinct_dest));
+}
+
+bool computeMatchingPlan(const ConvertedQuery &query, const GraphStats &stats, MatchingPlan &plan) {
+    ui n = query.vertex_num;
+    if (query.vertex_num_offset.size() != stats.label_num + 1) {
+        return false;
+    }
+
+    std::vector<LabelID> labels(n);
+    std::vector<double> candidates(n);
+    for (VertexID u = 0; u < n; u++) {
+        labels[u] = std::upper_bound(query.vertex_num_offset.begin(), query.vertex_num_offset.end(), u)
+                    - query.vertex_num_offset.begin() - 1;
+    }
+    for (VertexID u = 0; u < n; u++) {
+        candidates[u] = candidateCount(query, stats, labels, u);
+    }
+
+    plan.order.clear();
+    plan.pivot.clear();
+    plan.cardinality.clear();
+
+    std::vector<char> matched(n, 0);
+    std::vector<ui> backward(n, 0);         // edges between u and the matched vertices
+    double cardinality = 1;
+    for (ui i = 0; i < n; i++) {
+        // extend the matched vertices while they have unmatched neighbors, otherwise start a new component
+        bool connected = false;
+        for (VertexID u = 0; u < n; u++) {
+            connected = connected || (!matched[u] && backward[u] > 0);
+        }
+
+        VertexID next = n;
+        VertexID next_pivot = NO_PIVOT;
+        double next_growth = 0;
+        for (VertexID u = 0; u < n; u++) {
+            if (matched[u] || (connected && backward[u] == 0)) {
+                continue;
+            }
+
+            double growth = 0;
+            VertexID pivot = NO_PIVOT;
+            if (!connected) {
+                growth = candidates[u] / std::max<size_t>(1, query.out_neighbors[u].size() + query.in_neighbors[u].size());
+            } else {
+                // candidates come from the matched neighbor with the smallest average pair degree,
+                // every other backward edge keeps a candidate with its edge probability
+                growth = std::numeric_limits<double>::max();
+                double selectivity = 1;
+                double pivot_selectivity = 1;
+                for (VertexID w : query.out_neighbors[u]) {
+                    if (matched[w]) {
+                        const LabelPairStats &pair = stats.getPair(labels[u], labels[w]);
+                        selectivity *= edgeSelectivity(pair);
+                        if (pair.avg_in_degree < growth) {
+                            growth = pair.avg_in_degree;
+                            pivot = w;
+                            pivot_selectivity = edgeSelectivity(pair);
+                        }
+                    }
+                }
+                for (VertexID w : query.in_neighbors[u]) {
+                    if (matched[w]) {
+                        const LabelPairStats &pair = stats.getPair(labels[w], labels[u]);
+                        selectivity *= edgeSelectivity(pair);
+                        if (pair.avg_out_degree < growth) {
+                            growth = pair.avg_out_degree;
+                            pivot = w;
+                            pivot_selectivity = edgeSelectivity(pair);
+                        }
+                    }
+                }
+                growth = pivot_selectivity == 0 ? 0 : growth * selectivity / pivot_selectivity;
+            }
+
+            // ties go to more backward edges, then to fewer candidates
+            bool better = next == n || growth < next_growth
+                          || (growth == next_growth && backward[u] > backward[next])
+                          || (growth == next_growth && backward[u] == backward[next] && candidates[u] < candidates[next]);
+            if (better) {
+                next = u;
+                next_pivot = pivot;
+                next_growth = growth;
+            }
+        }
+
+        matched[next] = 1;
+        for (VertexID w : query.out_neighbors[next]) {
+            backward[w]++;
+        }
+        for (VertexID w : query.in_neighbors[next]) {
+            backward[w]++;
+        }
+        cardinality *= connected ? next_growth : candidates[next];
+        plan.order.push_back(next);
+        plan.pivot.push_back(next_pivot);
+        plan.cardinality.push_back(cardinality);
+    }
+    return true;
+}
+
+void writeMatchingPlan(std::ostream &descriptor, const MatchingPlan &plan) {
+    ui vertex_num = plan.order.size();
+    writeQuerySectionHeader(descriptor, QuerySection::MatchingOrder,
+                            sizeof(ui) + (sizeof(ui) * 2 + sizeof(double)) * (uint64_t)vertex_num);
+    descriptor.write((char*)&vertex_num, sizeof(ui));
+    descriptor.write((char*)plan.order.data(), sizeof(ui) * vertex_num);
+    descriptor.write((char*)plan.pivot.data(), sizeof(ui) * vertex_num);
+    descriptor.write((char*)plan.cardinality.data(), sizeof(double) * vertex_num);
+}
@@ -0,0 +1,37 @@
+#ifndef QUERY_PLAN_H
+#define QUERY_PLAN_H
+
+#include "type.h"
+#include "graph_stats.h"
+#include "query_convert.h"
+#include <ostream>
+#include <vector>
+
+#define NO_PIVOT 0xffffffff
+
+/*
+ * Matching order of a query with the estimates it was chosen by.
+ *
+ * Matching-order section payload (QuerySection::MatchingOrder):
+ *   ui vertex_num, ui order[vertex_num], ui pivot[vertex_num], double cardinality[vertex_num]
+ */
+struct MatchingPlan {
+    std::vector<VertexID> order;
+    std::vector<VertexID> pivot;            // matched neighbor whose adjacency yields the candidates of order[i], NO_PIVOT if none
+    std::vector<double> cardinality;        // estimated partial embeddings of order[0..i]
+};
+
+/*
+ * Greedy cost-based order over the label-pair statistics of the data graph.
+ * The start vertex has the fewest estimated candidates per query degree
+ * (label count filtered by the neighbor-label degree histograms). Each next
+ * vertex is the neighbor of the matched ones with the smallest estimated
+ * growth: the average pair degree from its cheapest matched neighbor times
+ * the edge probability of every other edge back into the matched vertices.
+ * Returns false if the statistics have a different number of labels.
+ */
+bool computeMatchingPlan(const ConvertedQuery &query, const GraphStats &stats, MatchingPlan &plan);
+
+void writeMatchingPlan(std::ostream &descriptor, const MatchingPlan &plan);
+
+#endif
@@ -0,0 +1,166 @@
+#include "query_sampler.h"
+#include <algorithm>
+#include <random>
+#include <set>
+
+static const ui BFS_NEIGHBOR_PROBES = 16;
+
+static bool allowedVertex(const DataGraph &graph, const SamplerConfig &config, VertexID v,
+                          const std::vector<ui> &label_count) {
+    LabelID label = graph.getLabel(v);
+    if (!config.allowed_labels.empty() && !config.allowed_labels[label]) {
+        return false;
+    }
+    return config.max_per_label == 0 || label_count[label] < config.max_per_label;
+}
+
+// The neighbor behind the index-th entry of v's out list followed by its in list
+static VertexID neighborAt(const DataGraph &graph, VertexID v, uint64_t index, bool &outgoing) {
+    ui out_degree = graph.getOutDegree(v);
+    outgoing = index < out_degree;
+    return outgoing ? graph.getOutNeighbors(v)[index] : graph.getInNeighbors(v)[index - out_degree];
+}
+
+bool sampleQuery(const DataGraph &graph, const SamplerConfig &config, uint64_t seed, ConvertedQuery &query) {
+    ui k = config.vertex_num;
+    if (k == 0 || k > graph.vertex_num) {
+        return false;
+    }
+
+    std::mt19937_64 rng(seed);
+    std::vector<VertexID> sampled;
+    std::vector<ui> label_count(graph.label_num);
+    std::set<std::pair<VertexID, VertexID> > tree_edges;
+
+    for (ui attempt = 0; attempt < config.max_attempts; attempt++) {
+        sampled.clear();
+        tree_edges.clear();
+        std::fill(label_count.begin(), label_count.end(), 0);
+
+        VertexID start = rng() % graph.vertex_num;
+        if (!allowedVertex(graph, config, start, label_count)) {
+            continue;
+        }
+        sampled.push_back(start);
+        label_count[graph.getLabel(start)]++;
+
+        // every vertex joins through an edge to an already sampled vertex, which keeps the sample connected
+        auto extend = [&](VertexID from, VertexID to, bool outgoing) {
+            if (std::find(sampled.begin(), sampled.end(), to) != sampled.end()) {
+                return false;
+            }
+            if (!allowedVertex(graph, config, to, label_count)) {
+                return false;
+            }
+            sampled.push_back(to);
+            label_count[graph.getLabel(to)]++;
+            tree_edges.insert(outgoing ? std::make_pair(from, to) : std::make_pair(to, from));
+            return true;
+        };
+
+        if (config.method == SampleMethod::RandomWalk) {
+            VertexID current = start;
+            for (ui step = 0; step < 100 * k && sampled.size() < k; step++) {
+                uint64_t degree = (uint64_t)graph.getOutDegree(current) + graph.getInDegree(current);
+                if (degree == 0) {
+                    break;
+                }
+                bool outgoing = false;
+                VertexID next = neighborAt(graph, current, rng() % degree, outgoing);
+                if (extend(current, next, outgoing)) {
+                    current = next;
+                } else if (std::find(sampled.begin(), sampled.end(), next) != sampled.end()) {
+                    current = next;
+                } else {
+                    // blocked by the label controls, continue from a random sampled vertex
+                    current = sampled[rng() % sampled.size()];
+                }
+            }
+        } else {
+            std::vector<uint64_t> probes;
+            for (ui head = 0; head < sampled.size() && sampled.size() < k; head++) {
+                VertexID current = sampled[head];
+                uint64_t degree = (uint64_t)graph.getOutDegree(current) + graph.getInDegree(current);
+
+                // small neighborhoods are visited in random order, large ones are probed at random
+                probes.clear();
+                if (degree <= BFS_NEIGHBOR_PROBES) {
+                    for (uint64_t i = 0; i < degree; i++) {
+                        probes.push_back(i);
+                    }
+                    std::shuffle(probes.begin(), probes.end(), rng);
+                } else {
+                    for (ui i = 0; i < BFS_NEIGHBOR_PROBES; i++) {
+                        probes.push_back(rng() % degree);
+                    }
+                }
+
+                for (ui i = 0; i < probes.size() && sampled.size() < k; i++) {
+                    bool outgoing = false;
+                    VertexID next = neighborAt(graph, current, probes[i], outgoing);
+                    extend(current, next, outgoing);
+                }
+            }
+        }
+
+        if (sampled.size() == k) {
+            break;
+        }
+    }
+
+    if (sampled.size() != k) {
+        return false;
+    }
+
+    std::sort(sampled.begin(), sampled.end());
+    std::vector<std::pair<VertexID, VertexID> > edges;
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    for (ui i = 0; i < k; i++) {
+        for (ui j = 0; j < k; j++) {
+            if (i == j || !graph.hasEdge(sampled[i], sampled[j])) {
+                continue;
+            }
+            if (tree_edges.count(std::make_pair(sampled[i], sampled[j])) == 0 && coin(rng) >= config.density) {
+                continue;
+            }
+            edges.push_back(std::make_pair(sampled[i], sampled[j]));
+        }
+    }
+    subgraphQuery(graph, sampled, edges, query);
+    return true;
+}
+
+void subgraphQuery(const DataGraph &graph, const std::vector<VertexID> &vertices,
+                   const std::vector<std::pair<VertexID, VertexID> > &edges, ConvertedQuery &query) {
+    // data IDs are grouped by label, so sorting them yields the query ID order
+    std::vector<VertexID> sorted(vertices);
+    std::sort(sorted.begin(), sorted.end());
+    ui k = sorted.size();
+
+    query.vertex_num = k;
+    query.edge_num = 0;
+    query.vertex_num_offset.assign(graph.label_num + 1, 0);
+    query.in_neighbors.assign(k, std::vector<VertexID>());
+    query.out_neighbors.assign(k, std::vector<VertexID>());
+
+    for (ui i = 0; i < k; i++) {
+        query.vertex_num_offset[graph.getLabel(sorted[i]) + 1]++;
+    }
+    for (ui i = 0; i < graph.label_num; i++) {
+        query.vertex_num_offset[i + 1] += query.vertex_num_offset[i];
+    }
+
+    for (auto &edge : edges) {
+        VertexID u = std::lower_bound(sorted.begin(), sorted.end(), edge.first) - sorted.begin();
+        VertexID v = std::lower_bound(sorted.begin(), sorted.end(), edge.second) - sorted.begin();
+        query.out_neighbors[u].push_back(v);
+        query.in_neighbors[v].push_back(u);
+    }
+    for (ui i = 0; i < k; i++) {
+        std::sort(query.out_neighbors[i].begin(), query.out_neighbors[i].end());
+        query.out_neighbors[i].erase(std::unique(query.out_neighbors[i].begin(), query.out_neighbors[i].end()), query.out_neighbors[i].end());
+        std::sort(query.in_neighbors[i].begin(), query.in_neighbors[i].end());
+        query.in_neighbors[i].erase(std::unique(query.in_neighbors[i].begin(), query.in_neighbors[i].end()), query.in_neighbors[i].end());
+        query.edge_num += query.out_neighbors[i].size();
+    }
+}
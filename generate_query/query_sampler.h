@@ -0,0 +1,38 @@
+#ifndef QUERY_SAMPLER_H
+#define QUERY_SAMPLER_H
+
+#include "type.h"
+#include "data_graph.h"
+#include "query_convert.h"
+#include <utility>
+#include <vector>
+
+enum SampleMethod {
+    RandomWalk = 0,
+    BreadthFirst = 1
+};
+
+struct SamplerConfig {
+    ui vertex_num;                          // vertices per query
+    double density;                         // share of the non-tree induced edges kept, 0 = spanning tree only
+    SampleMethod method;
+    std::vector<char> allowed_labels;       // empty = every label may appear in a query
+    ui max_per_label;                       // 0 = no limit
+    ui max_attempts;                        // start vertices tried before a sample is given up
+
+    SamplerConfig() : vertex_num(4), density(1.0), method(SampleMethod::RandomWalk), max_per_label(0), max_attempts(100) {}
+};
+
+/*
+ * Sample a connected subgraph of the data graph and store it as a query. The
+ * query edges are a subset of the data edges between the sampled vertices, so
+ * the sample itself is always an embedding of the query. The result only
+ * depends on the data graph, the configuration and the seed.
+ */
+bool sampleQuery(const DataGraph &graph, const SamplerConfig &config, uint64_t seed, ConvertedQuery &query);
+
+// The query made of the given data vertices and data edges between them (duplicate edges are merged)
+void subgraphQuery(const DataGraph &graph, const std::vector<VertexID> &vertices,
+                   const std::vector<std::pair<VertexID, VertexID> > &edges, ConvertedQuery &query);
+
+#endif
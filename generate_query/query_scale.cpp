@@ -0,0 +1,195 @@
+#include "query_scale.h"
+#include "query_estimate.h"
+#include "query_sampler.h"
+#include <algorithm>
+#include <random>
+
+bool findEmbedding(const ConvertedQuery &query, const DataGraph &graph, uint64_t seed, uint64_t budget,
+                   std::vector<VertexID> &embedding) {
+    ui n = query.vertex_num;
+    if (n == 0 || query.vertex_num_offset.size() != graph.label_num + 1) {
+        return false;
+    }
+    MatchingPlan plan;
+    connectedOrder(query, graph, plan);
+
+    std::mt19937_64 rng(seed);
+    embedding.assign(n, 0);
+    std::vector<char> matched(n, 0);
+
+    // candidates of the vertex at each depth: a run of the pivot's neighbors or a label range
+    std::vector<const VertexID*> choices(n, nullptr);
+    std::vector<VertexID> label_begin(n, 0);
+    std::vector<uint64_t> choice_num(n, 0);
+    std::vector<uint64_t> start(n, 0);
+    std::vector<uint64_t> tried(n, 0);
+    auto prepare = [&](ui i) {
+        VertexID u = plan.order[i];
+        LabelID label = std::upper_bound(query.vertex_num_offset.begin(), query.vertex_num_offset.end(), u)
+                        - query.vertex_num_offset.begin() - 1;
+        label_begin[i] = graph.vertex_num_offset[label];
+        VertexID label_end = graph.vertex_num_offset[label + 1];
+        VertexID p = plan.pivot[i];
+        if (p == NO_PIVOT) {
+            choices[i] = nullptr;
+            choice_num[i] = label_end - label_begin[i];
+        } else {
+            bool outgoing = std::binary_search(query.out_neighbors[p].begin(), query.out_neighbors[p].end(), u);
+            const VertexID* neighbors = outgoing ? graph.getOutNeighbors(embedding[p]) : graph.getInNeighbors(embedding[p]);
+            ui degree = outgoing ? graph.getOutDegree(embedding[p]) : graph.getInDegree(embedding[p]);
+            choices[i] = std::lower_bound(neighbors, neighbors + degree, label_begin[i]);
+            choice_num[i] = std::lower_bound(choices[i], neighbors + degree, label_end) - choices[i];
+        }
+        start[i] = choice_num[i] == 0 ? 0 : rng() % choice_num[i];
+        tried[i] = 0;
+    };
+
+    uint64_t checked = 0;
+    ui depth = 0;
+    prepare(0);
+    while (true) {
+        if (tried[depth] == choice_num[depth]) {
+            if (depth == 0) {
+                return false;
+            }
+            depth--;
+            matched[plan.order[depth]] = 0;
+            continue;
+        }
+        if (checked++ == budget) {
+            return false;
+        }
+
+        VertexID u = plan.order[depth];
+        uint64_t pick = (start[depth] + tried[depth]++) % choice_num[depth];
+        VertexID v = choices[depth] == nullptr ? label_begin[depth] + pick : choices[depth][pick];
+
+        bool valid = true;
+        for (ui j = 0; j < depth && valid; j++) {
+            valid = embedding[plan.order[j]] != v;
+        }
+        for (VertexID w : query.out_neighbors[u]) {
+            valid = valid && (w == u ? graph.hasEdge(v, v) : (!matched[w] || graph.hasEdge(v, embedding[w])));
+        }
+        for (VertexID w : query.in_neighbors[u]) {
+            valid = valid && (w == u || !matched[w] || graph.hasEdge(embedding[w], v));
+        }
+        if (!valid) {
+            continue;
+        }
+
+        embedding[u] = v;
+        matched[u] = 1;
+        if (depth + 1 == n) {
+            return true;
+        }
+        prepare(++depth);
+    }
+}
+
+bool scaleQuery(const ConvertedQuery &seed_query, const DataGraph &graph, const ScaleConfig &config, uint64_t seed,
+                ConvertedQuery &variant) {
+    ui n = seed_query.vertex_num;
+    ui k = config.vertex_num;
+    if (k == 0 || k > graph.vertex_num) {
+        return false;
+    }
+
+    std::mt19937_64 rng(seed);
+    std::vector<VertexID> embedding;
+    std::vector<VertexID> vertices;
+    std::vector<std::pair<VertexID, VertexID> > edges;
+    std::vector<char> kept;
+    std::vector<VertexID> frontier;
+
+    for (ui attempt = 0; attempt < config.max_attempts; attempt++) {
+        vertices.clear();
+        edges.clear();
+        if (!findEmbedding(seed_query, graph, rng(), config.search_budget, embedding)) {
+            continue;
+        }
+
+        // the seed vertices kept: a connected part grown from a random vertex, or all of them
+        kept.assign(n, k >= n);
+        if (k < n) {
+            VertexID first = rng() % n;
+            kept[first] = 1;
+            for (ui size = 1; size < k; size++) {
+                frontier.clear();
+                for (VertexID u = 0; u < n; u++) {
+                    if (kept[u]) {
+                        continue;
+                    }
+                    bool adjacent = false;
+                    for (VertexID w : seed_query.out_neighbors[u]) {
+                        adjacent = adjacent || kept[w];
+                    }
+                    for (VertexID w : seed_query.in_neighbors[u]) {
+                        adjacent = adjacent || kept[w];
+                    }
+                    if (adjacent) {
+                        frontier.push_back(u);
+                    }
+                }
+                // a disconnected seed continues with any remaining vertex
+                if (frontier.empty()) {
+                    for (VertexID u = 0; u < n; u++) {
+                        if (!kept[u]) {
+                            frontier.push_back(u);
+                        }
+                    }
+                }
+                kept[frontier[rng() % frontier.size()]] = 1;
+            }
+        }
+        for (VertexID u = 0; u < n; u++) {
+            if (!kept[u]) {
+                continue;
+            }
+            vertices.push_back(embedding[u]);
+            for (VertexID w : seed_query.out_neighbors[u]) {
+                if (kept[w]) {
+                    edges.push_back(std::make_pair(embedding[u], embedding[w]));
+                }
+            }
+        }
+
+        // grow along data edges from random vertices of the variant to new ones
+        for (ui step = 0; step < 100 * k && vertices.size() < k; step++) {
+            VertexID from = vertices[rng() % vertices.size()];
+            uint64_t out_degree = graph.getOutDegree(from);
+            uint64_t degree = out_degree + graph.getInDegree(from);
+            if (degree == 0) {
+                continue;
+            }
+            uint64_t index = rng() % degree;
+            bool outgoing = index < out_degree;
+            VertexID to = outgoing ? graph.getOutNeighbors(from)[index] : graph.getInNeighbors(from)[index - out_degree];
+            if (std::find(vertices.begin(), vertices.end(), to) != vertices.end()) {
+                continue;
+            }
+            vertices.push_back(to);
+            edges.push_back(outgoing ? std::make_pair(from, to) : std::make_pair(to, from));
+        }
+
+        if (vertices.size() == k) {
+            break;
+        }
+    }
+
+    if (vertices.size() != k) {
+        return false;
+    }
+
+    if (config.dense) {
+        for (VertexID v : vertices) {
+            for (VertexID w : vertices) {
+                if (v != w && graph.hasEdge(v, w)) {
+                    edges.push_back(std::make_pair(v, w));
+                }
+            }
+        }
+    }
+    subgraphQuery(graph, vertices, edges, variant);
+    return true;
+}
@@ -0,0 +1,38 @@
+#ifndef QUERY_SCALE_H
+#define QUERY_SCALE_H
+
+#include "type.h"
+#include "data_graph.h"
+#include "query_convert.h"
+#include <vector>
+
+struct ScaleConfig {
+    ui vertex_num;                          // vertices of the variant, smaller or larger than the seed query
+    bool dense;                             // keep every data edge between the variant's vertices
+    ui max_attempts;                        // embeddings of the seed query tried before a variant is given up
+    uint64_t search_budget;                 // candidates checked per embedding search
+
+    ScaleConfig() : vertex_num(4), dense(false), max_attempts(20), search_budget(1000000) {}
+};
+
+/*
+ * Random embedding of the query in the data graph by backtracking in a
+ * connected order, trying candidates from a random position onwards. Returns
+ * false if none is found within the budget; embedding[u] is the data vertex
+ * of query vertex u.
+ */
+bool findEmbedding(const ConvertedQuery &query, const DataGraph &graph, uint64_t seed, uint64_t budget,
+                   std::vector<VertexID> &embedding);
+
+/*
+ * Derive a variant of config.vertex_num vertices from a seed query, starting
+ * from an embedding of the seed. A smaller variant keeps a connected part of
+ * the embedding, a larger one grows it along data edges to new vertices. The
+ * sparse variant keeps the seed edges and the edges it grew along, the dense
+ * one every data edge between its vertices. Either way the vertices it was
+ * derived from are an embedding, so its result is never empty.
+ */
+bool scaleQuery(const ConvertedQuery &seed_query, const DataGraph &graph, const ScaleConfig &config, uint64_t seed,
+                ConvertedQuery &variant);
+
+#endif
@@ -0,0 +1,6 @@
+#include "query_section.h"
+
+void writeQuerySectionHeader(std::ostream &descriptor, ui tag, uint64_t size) {
+    descriptor.write((char*)&tag, sizeof(ui));
+    descriptor.write((char*)&size, sizeof(uint64_t));
+}
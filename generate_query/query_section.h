@@ -0,0 +1,28 @@
+#ifndef QUERY_SECTION_H
+#define QUERY_SECTION_H
+
+#include "type.h"
+#include <ostream>
+
+/*
+ * Optional sections of a query graph file.
+ *
+ * A query graph file has the same fixed layout as a data graph file:
+ *   ui vertex_num, ui size_vertex_num_offset, ui vertex_num_offset[size_vertex_num_offset],
+ *   ui in_degree[vertex_num], ui out_degree[vertex_num],
+ *   in-neighbor lists, out-neighbor lists.
+ * Optional sections follow it, each framed as
+ *   ui tag, uint64_t payload size in bytes, payload.
+ * Loaders which only read the fixed layout are unaffected, and loaders which
+ * understand sections can skip unknown tags by their size.
+ */
+enum QuerySection {
+    CanonicalHash = 1,      // uint64_t hash of the canonical form, equal for isomorphic queries
+    MatchingOrder = 2,      // matching order with estimated cardinalities, see query_plan.h
+    CardinalityEstimate = 3,     // estimated number of embeddings, see query_estimate.h
+    SymmetryConstraints = 4     // automorphism group order and symmetry-breaking constraints, see query_symmetry.h
+};
+
+void writeQuerySectionHeader(std::ostream &descriptor, ui tag, uint64_t size);
+
+#endif
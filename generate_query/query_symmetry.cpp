@@ -0,0 +1,143 @@
+#include "query_symmetry.h"
+#include "query_section.h"
+#include <algorithm>
+#include <numeric>
+
+typedef std::vector<VertexID> Permutation;
+
+// a after b
+static Permutation compose(const Permutation &a, const Permutation &b) {
+    Permutation result(b.size());
+    for (ui v = 0; v < b.size(); v++) {
+        result[v] = a[b[v]];
+    }
+    return result;
+}
+
+// the inverse of a after b
+static Permutation divide(const Permutation &a, const Permutation &b) {
+    Permutation inverse(a.size());
+    for (ui v = 0; v < a.size(); v++) {
+        inverse[a[v]] = v;
+    }
+    return compose(inverse, b);
+}
+
+/*
+ * Stabilizer chain with base 0, 1, ..., n - 1 (Knuth's formulation). Level k
+ * is the stabilizer of the vertices below k; transversal[k][v] is one of its
+ * permutations which maps k to v, or empty if v is not in the orbit of k.
+ */
+struct SchreierSims {
+    ui n;
+    std::vector<std::vector<Permutation> > generators;
+    std::vector<std::vector<Permutation> > transversal;
+
+    explicit SchreierSims(ui vertex_num) : n(vertex_num), generators(vertex_num), transversal(vertex_num, std::vector<Permutation>(vertex_num)) {
+        for (ui k = 0; k < n; k++) {
+            transversal[k][k].resize(n);
+            std::iota(transversal[k][k].begin(), transversal[k][k].end(), 0);
+        }
+    }
+
+    // Sift g down from level k
+    bool contains(ui k, Permutation g) const {
+        for (; k < n; k++) {
+            const Permutation &t = transversal[k][g[k]];
+            if (t.empty()) {
+                return false;
+            }
+            g = divide(t, g);
+        }
+        return true;
+    }
+
+    // g fixes the vertices below k
+    void add(ui k, const Permutation &g) {
+        if (k >= n || contains(k, g)) {
+            return;
+        }
+        generators[k].push_back(g);
+        std::vector<VertexID> orbit;
+        for (VertexID v = 0; v < n; v++) {
+            if (!transversal[k][v].empty()) {
+                orbit.push_back(v);
+            }
+        }
+        for (VertexID v : orbit) {
+            extend(k, compose(g, transversal[k][v]));
+        }
+    }
+
+    // t is in level k: either it reaches a new orbit vertex, or it yields a Schreier generator of level k + 1
+    void extend(ui k, const Permutation &t) {
+        VertexID v = t[k];
+        if (!transversal[k][v].empty()) {
+            add(k + 1, divide(transversal[k][v], t));
+            return;
+        }
+        transversal[k][v] = t;
+        for (ui i = 0; i < generators[k].size(); i++) {
+            extend(k, compose(generators[k][i], t));
+        }
+    }
+};
+
+void breakSymmetry(ui vertex_num, const std::vector<std::vector<VertexID> > &generators, SymmetryBreaking &symmetry) {
+    SchreierSims chain(vertex_num);
+    for (auto const& generator : generators) {
+        chain.add(0, generator);
+    }
+
+    symmetry.automorphism_num = 1;
+    symmetry.constraints.clear();
+    symmetry.base.clear();
+    symmetry.orbit_sizes.clear();
+
+    // the orbit of b only holds vertices above b, so the constraints point from lower to higher IDs
+    std::vector<std::vector<VertexID> > above(vertex_num);
+    for (VertexID b = 0; b < vertex_num; b++) {
+        ui orbit_size = 0;
+        for (VertexID v = 0; v < vertex_num; v++) {
+            if (chain.transversal[b][v].empty()) {
+                continue;
+            }
+            orbit_size++;
+            if (v != b) {
+                above[b].push_back(v);
+            }
+        }
+        if (orbit_size > 1) {
+            symmetry.base.push_back(b);
+            symmetry.orbit_sizes.push_back(orbit_size);
+            symmetry.automorphism_num *= orbit_size;
+        }
+    }
+
+    // transitive reduction: skip u < w if it follows from u < v and v < ... < w
+    std::vector<std::vector<char> > implied(vertex_num, std::vector<char>(vertex_num, 0));
+    for (VertexID u = vertex_num; u-- > 0;) {
+        for (VertexID v : above[u]) {
+            if (implied[u][v]) {
+                continue;
+            }
+            symmetry.constraints.push_back(std::make_pair(u, v));
+            implied[u][v] = 1;
+            for (VertexID w = v + 1; w < vertex_num; w++) {
+                implied[u][w] = implied[u][w] || implied[v][w];
+            }
+        }
+    }
+    std::sort(symmetry.constraints.begin(), symmetry.constraints.end());
+}
+
+void writeSymmetryBreaking(std::ostream &descriptor, const SymmetryBreaking &symmetry) {
+    ui constraint_num = symmetry.constraints.size();
+    writeQuerySectionHeader(descriptor, QuerySection::SymmetryConstraints, sizeof(double) + sizeof(ui) * (1 + 2 * (uint64_t)constraint_num));
+    descriptor.write((char*)&symmetry.automorphism_num, sizeof(double));
+    descriptor.write((char*)&constraint_num, sizeof(ui));
+    for (auto const& constraint : symmetry.constraints) {
+        descriptor.write((char*)&constraint.first, sizeof(VertexID));
+        descriptor.write((char*)&constraint.second, sizeof(VertexID));
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef QUERY_SYMMETRY_H
+#define QUERY_SYMMETRY_H
+
+#include "type.h"
+#include <ostream>
+#include <utility>
+#include <vector>
+
+/*
+ * Automorphism group of a query and the partial order which breaks it.
+ *
+ * Symmetry-breaking section payload (QuerySection::SymmetryConstraints):
+ *   double automorphism_num, ui constraint_num,
+ *   constraint_num pairs of ui (u, v), each meaning f(u) < f(v) for an embedding f
+ * Exactly one embedding of every class of automorphic embeddings satisfies
+ * all constraints, so a matcher which checks them finds
+ * embeddings / automorphism_num results.
+ */
+struct SymmetryBreaking {
+    double automorphism_num;                // order of the automorphism group, as a double since it can pass 2^64
+    std::vector<std::pair<VertexID, VertexID> > constraints;
+    std::vector<VertexID> base;             // stabilizer chain base points, the vertices constraints start from
+    std::vector<ui> orbit_sizes;            // orbit of base[i] under the stabilizer of base[0..i-1]
+
+    SymmetryBreaking() : automorphism_num(1) {}
+};
+
+/*
+ * Schreier-Sims over the generators found by the canonical labeling search
+ * (CanonicalForm::generators), with the vertices in ID order as base. For
+ * every base point b whose orbit under the stabilizer of the earlier base
+ * points is not trivial, b has to map below every other vertex of its orbit
+ * (Grochow and Kellis). Constraints implied by the others are left out.
+ */
+void breakSymmetry(ui vertex_num, const std::vector<std::vector<VertexID> > &generators, SymmetryBreaking &symmetry);
+
+void writeSymmetryBreaking(std::ostream &descriptor, const SymmetryBreaking &symmetry);
+
+#endif
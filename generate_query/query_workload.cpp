@@ -0,0 +1,219 @@
+#include "query_workload.h"
+#include "query_section.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static uint64_t alignUp(uint64_t offset) {
+    return (offset + 7) & ~7ULL;
+}
+
+// Metadata of one serialized query graph, read from its fixed layout and its sections
+static void describeQuery(const std::string &query, WorkloadEntry &entry, std::vector<LabelID> &query_labels) {
+    const char* data = query.data();
+    ui vertex_num = 0;
+    ui size_vertex_num_offset = 0;
+    std::memcpy(&vertex_num, data, sizeof(ui));
+    std::memcpy(&size_vertex_num_offset, data + sizeof(ui), sizeof(ui));
+
+    std::vector<ui> vertex_num_offset(size_vertex_num_offset);
+    std::vector<ui> in_degree(vertex_num);
+    std::vector<ui> out_degree(vertex_num);
+    uint64_t position = sizeof(ui) * 2;
+    std::memcpy(vertex_num_offset.data(), data + position, sizeof(ui) * size_vertex_num_offset);
+    position += sizeof(ui) * size_vertex_num_offset;
+    std::memcpy(in_degree.data(), data + position, sizeof(ui) * vertex_num);
+    position += sizeof(ui) * vertex_num;
+    std::memcpy(out_degree.data(), data + position, sizeof(ui) * vertex_num);
+    position += sizeof(ui) * vertex_num;
+    for (ui u = 0; u < vertex_num; u++) {
+        position += sizeof(VertexID) * ((uint64_t)in_degree[u] + out_degree[u]);
+    }
+
+    entry.vertex_num = vertex_num;
+    entry.edge_num = 0;
+    for (ui u = 0; u < vertex_num; u++) {
+        entry.edge_num += out_degree[u];
+    }
+    entry.density = vertex_num < 2 ? 0 : (double)entry.edge_num / ((double)vertex_num * (vertex_num - 1));
+
+    query_labels.clear();
+    for (ui l = 0; l + 1 < size_vertex_num_offset; l++) {
+        if (vertex_num_offset[l + 1] > vertex_num_offset[l]) {
+            query_labels.push_back(l);
+        }
+    }
+
+    entry.canonical_hash = 0;
+    entry.estimate = -1;
+    while (position + sizeof(ui) + sizeof(uint64_t) <= query.size()) {
+        ui tag = 0;
+        uint64_t size = 0;
+        std::memcpy(&tag, data + position, sizeof(ui));
+        std::memcpy(&size, data + position + sizeof(ui), sizeof(uint64_t));
+        position += sizeof(ui) + sizeof(uint64_t);
+        if (tag == QuerySection::CanonicalHash && size >= sizeof(uint64_t)) {
+            std::memcpy(&entry.canonical_hash, data + position, sizeof(uint64_t));
+        } else if (tag == QuerySection::CardinalityEstimate && size >= sizeof(ui) + sizeof(double)) {
+            std::memcpy(&entry.estimate, data + position + sizeof(ui), sizeof(double));
+        }
+        position += size;
+    }
+}
+
+bool writeWorkload(const std::string &file_path, const std::vector<std::string> &names, const std::vector<std::string> &queries) {
+    ui query_num = queries.size();
+    std::vector<WorkloadEntry> index(query_num);
+    std::string name_blob;
+    std::vector<LabelID> label_blob;
+    std::vector<LabelID> query_labels;
+
+    for (ui i = 0; i < query_num; i++) {
+        WorkloadEntry &entry = index[i];
+        describeQuery(queries[i], entry, query_labels);
+        entry.size = queries[i].size();
+        entry.name_offset = name_blob.size();
+        entry.name_length = names[i].size();
+        entry.label_offset = label_blob.size();
+        entry.label_num = query_labels.size();
+        name_blob += names[i];
+        label_blob.insert(label_blob.end(), query_labels.begin(), query_labels.end());
+    }
+
+    WorkloadHeader header;
+    header.magic = WORKLOAD_MAGIC;
+    header.query_num = query_num;
+    header.index_offset = alignUp(sizeof(WorkloadHeader));
+    header.name_offset = alignUp(header.index_offset + sizeof(WorkloadEntry) * query_num);
+    header.label_offset = alignUp(header.name_offset + name_blob.size());
+    header.data_offset = alignUp(header.label_offset + sizeof(LabelID) * label_blob.size());
+    uint64_t offset = header.data_offset;
+    for (ui i = 0; i < query_num; i++) {
+        index[i].offset = offset;
+        offset = alignUp(offset + index[i].size);
+    }
+    header.file_size = offset;
+
+    std::ofstream descriptor(file_path, std::ios::binary);
+    const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    uint64_t written = 0;
+    auto pad = [&](uint64_t target) {
+        descriptor.write(padding, target - written);
+        written = target;
+    };
+
+    descriptor.write((char*)&header, sizeof(WorkloadHeader));
+    written = sizeof(WorkloadHeader);
+    pad(header.index_offset);
+    descriptor.write((char*)index.data(), sizeof(WorkloadEntry) * query_num);
+    written += sizeof(WorkloadEntry) * query_num;
+    pad(header.name_offset);
+    descriptor.write(name_blob.data(), name_blob.size());
+    written += name_blob.size();
+    pad(header.label_offset);
+    descriptor.write((char*)label_blob.data(), sizeof(LabelID) * label_blob.size());
+    written += sizeof(LabelID) * label_blob.size();
+    for (ui i = 0; i < query_num; i++) {
+        pad(index[i].offset);
+        descriptor.write(queries[i].data(), queries[i].size());
+        written += queries[i].size();
+    }
+    pad(header.file_size);
+    descriptor.close();
+    if (descriptor.fail()) {
+        std::cout << "cannot write workload file " << file_path << "!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+Workload::~Workload() {
+    unload();
+}
+
+void Workload::unload() {
+    if (mapped != nullptr) {
+        munmap(mapped, mapped_size);
+    }
+    mapped = nullptr;
+    mapped_size = 0;
+    query_num = 0;
+    index = nullptr;
+    names = nullptr;
+    labels = nullptr;
+}
+
+// Every offset of the header and the index points into the file and the parts do not overlap
+static bool validWorkload(const WorkloadHeader* header, uint64_t mapped_size) {
+    if (header->file_size > mapped_size || header->index_offset % 8 != 0 || header->label_offset % sizeof(LabelID) != 0
+        || header->index_offset < sizeof(WorkloadHeader) || header->index_offset > header->name_offset
+        || (header->name_offset - header->index_offset) / sizeof(WorkloadEntry) < header->query_num
+        || header->name_offset > header->label_offset || header->label_offset > header->data_offset
+        || header->data_offset > header->file_size) {
+        return false;
+    }
+    const WorkloadEntry* index = (const WorkloadEntry*)((const char*)header + header->index_offset);
+    uint64_t name_size = header->label_offset - header->name_offset;
+    uint64_t label_size = (header->data_offset - header->label_offset) / sizeof(LabelID);
+    for (ui i = 0; i < header->query_num; i++) {
+        const WorkloadEntry &entry = index[i];
+        if (entry.name_offset > name_size || entry.name_length > name_size - entry.name_offset
+            || entry.label_offset > label_size || entry.label_num > label_size - entry.label_offset
+            || entry.offset < header->data_offset || entry.offset > header->file_size
+            || entry.size > header->file_size - entry.offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Workload::load(const std::string &file_path) {
+    unload();
+    int fd = open(file_path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cout << "wrong path! (workload file)" << std::endl;
+        return false;
+    }
+    struct stat file_stat;
+    fstat(fd, &file_stat);
+    size_t file_size = file_stat.st_size;
+    void* file = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (file == MAP_FAILED) {
+        std::cout << "cannot map workload file!" << std::endl;
+        return false;
+    }
+    mapped = file;
+    mapped_size = file_size;
+
+    const WorkloadHeader* header = (const WorkloadHeader*)mapped;
+    if (mapped_size < sizeof(WorkloadHeader) || header->magic != WORKLOAD_MAGIC) {
+        std::cout << "not a workload file!" << std::endl;
+        unload();
+        return false;
+    }
+    if (!validWorkload(header, mapped_size)) {
+        std::cout << "truncated or corrupt workload file!" << std::endl;
+        unload();
+        return false;
+    }
+    query_num = header->query_num;
+    index = (const WorkloadEntry*)((const char*)mapped + header->index_offset);
+    names = (const char*)mapped + header->name_offset;
+    labels = (const LabelID*)((const char*)mapped + header->label_offset);
+    return true;
+}
+
+bool Workload::findByHash(uint64_t hash, ui &i) const {
+    for (ui j = 0; j < query_num; j++) {
+        if (index[j].canonical_hash == hash) {
+            i = j;
+            return true;
+        }
+    }
+    return false;
+}
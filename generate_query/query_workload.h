@@ -0,0 +1,87 @@
+#ifndef QUERY_WORKLOAD_H
+#define QUERY_WORKLOAD_H
+
+#include "type.h"
+#include <string>
+#include <vector>
+
+/*
+ * Workload file (-pack): many query graphs in one file, laid out to be used
+ * through mmap.
+ *
+ * Layout (every section starts 8-byte aligned):
+ *   WorkloadHeader,
+ *   WorkloadEntry index[query_num],
+ *   char names[],                  query names, not null-terminated
+ *   LabelID labels[],              distinct labels of each query, in label order
+ *   query graphs,                  each one a complete query graph file, 8-byte aligned
+ * Offsets are from the start of the file. The canonical hash and the estimate
+ * are copied from the query's own sections when it has them.
+ */
+#define WORKLOAD_MAGIC 0x314b5751     // "QWK1"
+
+struct WorkloadHeader {
+    ui magic;
+    ui query_num;
+    uint64_t index_offset;
+    uint64_t name_offset;
+    uint64_t label_offset;
+    uint64_t data_offset;
+    uint64_t file_size;
+};
+
+struct WorkloadEntry {
+    uint64_t offset;                // query graph bytes
+    uint64_t size;
+    uint64_t canonical_hash;        // 0 if the query has no canonical hash section
+    double density;                 // edge_num / (vertex_num * (vertex_num - 1))
+    double estimate;                // sampled embedding estimate, negative if not computed
+    ui vertex_num;
+    ui edge_num;
+    ui name_offset;                 // into names
+    ui name_length;
+    ui label_offset;                // into labels
+    ui label_num;
+};
+
+// queries[i] holds the serialized query graph (with its sections) named names[i]; false if the file cannot be written
+bool writeWorkload(const std::string &file_path, const std::vector<std::string> &names, const std::vector<std::string> &queries);
+
+class Workload {
+private:
+    void* mapped;
+    size_t mapped_size;
+    ui query_num;
+    const WorkloadEntry* index;
+    const char* names;
+    const LabelID* labels;
+
+    void unload();
+
+public:
+    Workload() : mapped(nullptr), mapped_size(0), query_num(0), index(nullptr), names(nullptr), labels(nullptr) {}
+    ~Workload();
+
+    // owns the mapping, so copies would unmap it twice
+    Workload(const Workload &) = delete;
+    Workload& operator=(const Workload &) = delete;
+
+    // Replaces a previously loaded file; false if the file is missing or its offsets are out of range
+    bool load(const std::string &file_path);
+
+    ui getQueryNum() const { return query_num; }
+
+    const WorkloadEntry& getEntry(ui i) const { return index[i]; }
+
+    std::string getName(ui i) const { return std::string(names + index[i].name_offset, index[i].name_length); }
+
+    const LabelID* getLabels(ui i) const { return labels + index[i].label_offset; }
+
+    // bytes of the i-th query graph file, index[i].size long
+    const char* getQuery(ui i) const { return (const char*)mapped + index[i].offset; }
+
+    // Returns false if no query has this canonical hash
+    bool findByHash(uint64_t hash, ui &i) const;
+};
+
+#endif
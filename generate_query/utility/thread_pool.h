@@ -0,0 +1,48 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/*
+ * Fixed-size pool for batch work: run() hands out task indices [0, n) one at a
+ * time to the worker threads, so uneven tasks still balance, and returns once
+ * every task has finished.
+ */
+class ThreadPool {
+private:
+    unsigned thread_num;
+
+public:
+    explicit ThreadPool(unsigned threads = 0)
+            : thread_num(threads != 0 ? threads : std::max(1U, std::thread::hardware_concurrency())) {}
+
+    unsigned getThreadNum() const {
+        return thread_num;
+    }
+
+    // task(thread, index) for every index in [0, n)
+    template <typename Task>
+    void run(unsigned n, Task task) {
+        std::atomic<unsigned> next(0);
+        auto worker = [&](unsigned thread) {
+            for (unsigned i = next++; i < n; i = next++) {
+                task(thread, i);
+            }
+        };
+
+        unsigned worker_num = std::min(thread_num, std::max(1U, n));
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < worker_num; t++) {
+            threads.emplace_back(worker, t);
+        }
+        worker(0);
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+};
+
+#endif
@@ -4888,6 +4888,7 @@ namespace csv {
 #include <iterator>
 #include <stdexcept>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 
@@ -4911,6 +4912,69 @@ namespace csv {
         int header_row;
     };
 
+    /** A condition on one field which a row must meet to be kept
+     *
+     *  Filters are added with CSVFormat::filter() and are evaluated by the
+     *  parser on the raw field text as soon as a row is complete, so rejected
+     *  rows are never queued or handed out as CSVRow objects. Columns are
+     *  looked up by name once the header row has been parsed.
+     */
+    class FieldFilter {
+    public:
+        /** Field equals value */
+        static FieldFilter equals(const std::string& column, const std::string& value) {
+            return in(column, { value });
+        }
+
+        /** Field equals one of values */
+        static FieldFilter in(const std::string& column, const std::vector<std::string>& values) {
+            FieldFilter ret(column, Op::IN);
+            ret.values.insert(values.begin(), values.end());
+            return ret;
+        }
+
+        /** Field starts with prefix */
+        static FieldFilter prefix(const std::string& column, const std::string& prefix) {
+            FieldFilter ret(column, Op::PREFIX);
+            ret.lower = prefix;
+            return ret;
+        }
+
+        /** lower <= field < upper, comparing bytes (e.g. for ISO 8601 timestamps) */
+        static FieldFilter range(const std::string& column, const std::string& lower, const std::string& upper) {
+            FieldFilter ret(column, Op::RANGE);
+            ret.lower = lower;
+            ret.upper = upper;
+            return ret;
+        }
+
+        /** lower <= field <= upper, rejecting fields which are not numbers */
+        static FieldFilter numeric_range(const std::string& column, long double lower, long double upper) {
+            FieldFilter ret(column, Op::NUMERIC_RANGE);
+            ret.num_lower = lower;
+            ret.num_upper = upper;
+            return ret;
+        }
+
+        const std::string& get_column() const noexcept { return this->column; }
+
+        /** Whether a field with this (unescaped) text passes the filter */
+        bool matches(csv::string_view field) const;
+
+    private:
+        enum class Op { IN, PREFIX, RANGE, NUMERIC_RANGE };
+
+        FieldFilter(const std::string& column, Op op) : column(column), op(op) {}
+
+        std::string column;
+        Op op;
+        std::unordered_set<std::string> values;
+        std::string lower;
+        std::string upper;
+        long double num_lower = 0;
+        long double num_upper = 0;
+    };
+
     /** Stores information about how to parse a CSV file.
      *  Can be used to construct a csv::CSVReader. 
      */
@@ -4973,6 +5037,15 @@ namespace csv {
             return *this;
         }
 
+        /** Only keep rows which pass this filter (in addition to any previously added ones)
+         *
+         *  @note Rows up to and including the header row are never filtered
+         */
+        CSVFormat& filter(const FieldFilter& field_filter) {
+            this->filters.push_back(field_filter);
+            return *this;
+        }
+
         /** Tells the parser how to handle columns of a different length than the others */
         CONSTEXPR_14 CSVFormat& variable_columns(VariableColumnPolicy policy = VariableColumnPolicy::IGNORE_ROW) {
             this->variable_column_policy = policy;
@@ -5000,6 +5073,7 @@ namespace csv {
         CONSTEXPR int get_header() const { return this->header; }
         std::vector<char> get_possible_delims() const { return this->possible_delimiters; }
         std::vector<char> get_trim_chars() const { return this->trim_chars; }
+        const std::vector<FieldFilter>& get_filters() const { return this->filters; }
         CONSTEXPR VariableColumnPolicy get_variable_column_policy() const { return this->variable_column_policy; }
         #endif
         
@@ -5044,6 +5118,9 @@ namespace csv {
 
         /**< Allow variable length columns? */
         VariableColumnPolicy variable_column_policy = VariableColumnPolicy::IGNORE_ROW;
+
+        /**< Conditions every row must meet to be kept */
+        std::vector<FieldFilter> filters = {};
     };
 }
 /** @file
@@ -5483,6 +5560,18 @@ namespace csv {
                 return this->_current_buffer_size + ((this->buffers.size() - 1) * this->_single_buffer_capacity);
             }
 
+            /** Discard every field after the first n, e.g. those of a filtered out row */
+            void truncate(size_t n) noexcept {
+                const size_t keep_buffers = n == 0 ? 1 : (n - 1) / this->_single_buffer_capacity + 1;
+                while (this->buffers.size() > keep_buffers) {
+                    delete[] this->buffers.back();
+                    this->buffers.pop_back();
+                }
+
+                this->_current_buffer_size = n - (keep_buffers - 1) * this->_single_buffer_capacity;
+                this->_back = this->buffers.back() + this->_current_buffer_size;
+            }
+
             RawCSVField& operator[](size_t n) const;
 
         private:
@@ -5844,6 +5933,9 @@ inline std::ostream& operator << (std::ostream& os, csv::CSVField const& value)
     return os;
 }
 
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace csv {
     namespace internals {
@@ -5910,6 +6002,35 @@ namespace csv {
         /** Read the first 500KB of a CSV file */
         CSV_INLINE std::string get_csv_head(csv::string_view filename, size_t file_size);
 
+        /** State carried between blocks by the quote-aware row counter */
+        struct RowScanState {
+            size_t rows = 0;           /**< Line terminators seen outside of quoted fields */
+            bool quote_escape = false; /**< Whether the scan is inside a quoted field */
+            bool after_cr = false;     /**< Whether the last character was an unquoted '\r' */
+            char last_char = '\0';     /**< Last character of the previous block */
+        };
+
+        /** Count '\n' characters in a block using SIMD compares where available
+         *
+         *  @param[out] needs_fallback Set to true if the block contains a quote
+         *                             character or a '\r', in which case the count
+         *                             cannot be trusted and count_rows_quoted() must be used
+         */
+        CSV_INLINE size_t count_newlines(const char* data, size_t length,
+            int quote_char, bool& needs_fallback) noexcept;
+
+        /** Count line terminators (LF, CRLF or a lone CR) which are not inside a quoted field */
+        CSV_INLINE void count_rows_quoted(const char* data, size_t length,
+            int quote_char, RowScanState& state) noexcept;
+
+        /** Count the records in a file without tokenizing it
+         *
+         *  @note Every line terminator outside of a quoted field ends a record, so
+         *        blank lines and rows with the wrong number of columns are counted
+         *        even though CSVReader would drop them.
+         */
+        CSV_INLINE size_t count_rows(csv::string_view filename, const CSVFormat& format);
+
         /** A std::deque wrapper which allows multiple read and write threads to concurrently
          *  access it along with providing read threads the ability to wait for the deque
          *  to become populated
@@ -6047,6 +6168,9 @@ namespace csv {
 
             void set_output(RowCollection& rows) { this->_records = &rows; }
 
+            /** Describes a filter which could not be applied, or is empty */
+            const std::string& filter_error() const noexcept { return this->_filter_error; }
+
         protected:
             /** @name Current Parser State */
             ///@{
@@ -6098,6 +6222,20 @@ namespace csv {
             /** Where complete rows should be pushed to */
             RowCollection* _records = nullptr;
 
+            /** @name Row Filtering */
+            ///@{
+            std::vector<FieldFilter> _filters;
+
+            /** Column index for each filter, CSV_NOT_FOUND until resolved */
+            std::vector<int> _filter_cols;
+
+            /** Rows up to and including this one are never filtered */
+            int _header_row = -1;
+            size_t _rows_seen = 0;
+            std::string _filter_error;
+            std::string _filter_buffer;
+            ///@}
+
             CONSTEXPR_17 bool ws_flag(const char ch) const noexcept {
                 return _ws_flags.data()[ch + 128];
             }
@@ -6114,6 +6252,15 @@ namespace csv {
             /** Finish parsing the current row */
             void push_row();
 
+            /** Text of a field in the current row, with escaped quotes removed */
+            csv::string_view current_field(size_t index, std::string& buffer) const;
+
+            /** Look up filter columns by name */
+            void resolve_filters(const std::vector<std::string>& col_names);
+
+            /** Whether the current row passes every filter */
+            bool filter_row();
+
             /** Handle possible Unicode byte order mark */
             void trim_utf8_bom();
         };
@@ -6419,6 +6566,9 @@ namespace csv {
         void initial_read() {
             this->read_csv_worker = std::thread(&CSVReader::read_csv, this, internals::ITERATION_CHUNK_SIZE);
             this->read_csv_worker.join();
+
+            if (!this->parser->filter_error().empty())
+                throw std::runtime_error(this->parser->filter_error());
         }
 
         void trim_header();
@@ -6429,16 +6579,271 @@ namespace csv {
  *  Calculates statistics from CSV files
  */
 
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <unordered_map>
 #include <sstream>
 #include <vector>
 
 namespace csv {
+    namespace internals {
+        /** A fixed set of worker threads which run the same task on every batch
+         *  of work they are given
+         *
+         *  Workers are created once and parked on a condition variable between
+         *  batches, so callers which process many small batches do not pay
+         *  thread creation costs for each of them.
+         */
+        class WorkerPool {
+        public:
+            /** @param[in] n_workers Number of threads to create
+             *  @param[in] task      Called as task(worker_id) once per batch on every worker
+             */
+            WorkerPool(size_t n_workers, std::function<void(size_t)> task) :
+                _task(std::move(task)), _errors(n_workers) {
+                for (size_t i = 0; i < n_workers; i++)
+                    _workers.push_back(std::thread(&WorkerPool::worker_loop, this, i));
+            }
+
+            WorkerPool(const WorkerPool&) = delete;
+            WorkerPool& operator=(const WorkerPool&) = delete;
+
+            ~WorkerPool() {
+                {
+                    std::unique_lock<std::mutex> lock{ this->_lock };
+                    this->_stop = true;
+                    this->_start_cond.notify_all();
+                }
+
+                for (auto& th : _workers)
+                    th.join();
+            }
+
+            size_t size() const noexcept { return this->_workers.size(); }
+
+            /** Wake every worker to process a new batch. Does not block. */
+            void start() {
+                std::unique_lock<std::mutex> lock{ this->_lock };
+                this->_busy = this->_workers.size();
+                this->_generation++;
+                this->_start_cond.notify_all();
+            }
+
+            /** Block until the current batch is finished
+             *
+             *  @throws Rethrows the first exception thrown by a worker
+             */
+            void wait() {
+                std::unique_lock<std::mutex> lock{ this->_lock };
+                this->_done_cond.wait(lock, [this] { return this->_busy == 0; });
+
+                for (auto& error : this->_errors) {
+                    if (error) {
+                        auto rethrow = error;
+                        error = nullptr;
+                        std::rethrow_exception(rethrow);
+                    }
+                }
+            }
+
+        private:
+            std::function<void(size_t)> _task;
+            std::vector<std::thread> _workers;
+            std::vector<std::exception_ptr> _errors;
+            std::mutex _lock;
+            std::condition_variable _start_cond;
+            std::condition_variable _done_cond;
+            size_t _generation = 0;
+            size_t _busy = 0;
+            bool _stop = false;
+
+            void worker_loop(size_t worker) {
+                size_t seen_generation = 0;
+
+                while (true) {
+                    {
+                        std::unique_lock<std::mutex> lock{ this->_lock };
+                        this->_start_cond.wait(lock, [&] {
+                            return this->_stop || this->_generation != seen_generation;
+                        });
+
+                        if (this->_stop) return;
+                        seen_generation = this->_generation;
+                    }
+
+                    try {
+                        this->_task(worker);
+                    }
+                    catch (...) {
+                        this->_errors[worker] = std::current_exception();
+                    }
+
+                    std::unique_lock<std::mutex> lock{ this->_lock };
+                    if (--this->_busy == 0)
+                        this->_done_cond.notify_all();
+                }
+            }
+        };
+    }
+
+    namespace internals {
+        /** 64-bit FNV-1a hash followed by a splitmix64 finalizer so that all bits
+         *  are usable by the sketches below
+         */
+        inline uint64_t hash_string(csv::string_view s) noexcept {
+            uint64_t hash = 14695981039346656037ULL;
+            for (char ch : s) {
+                hash ^= (unsigned char)ch;
+                hash *= 1099511628211ULL;
+            }
+
+            hash ^= hash >> 30;
+            hash *= 0xbf58476d1ce4e5b9ULL;
+            hash ^= hash >> 27;
+            hash *= 0x94d049bb133111ebULL;
+            hash ^= hash >> 31;
+            return hash;
+        }
+
+        /** Number of leading zero bits in a 64-bit word (64 if x == 0) */
+        inline int leading_zeros(uint64_t x) noexcept {
+            if (x == 0) return 64;
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_clzll(x);
+#else
+            int n = 0;
+            while (!(x & (1ULL << 63))) {
+                x <<= 1;
+                n++;
+            }
+            return n;
+#endif
+        }
+    }
+
+    /** Estimates the number of distinct values in a column using HyperLogLog
+     *
+     *  Uses 2^precision one-byte registers regardless of how many values are
+     *  added. The relative standard error is about 1.04 / sqrt(2^precision),
+     *  i.e. ~1.6% for the default precision of 12.
+     *
+     *  Sketches with the same precision can be merged, e.g. across threads or files.
+     */
+    class HyperLogLog {
+    public:
+        HyperLogLog(unsigned precision = 12);
+
+        void add(csv::string_view item) { this->add_hash(internals::hash_string(item)); }
+        void add_hash(uint64_t hash) noexcept;
+
+        /** Combine with a sketch built over another set of values
+         *
+         *  @throws `std::runtime_error` if the precisions differ
+         */
+        void merge(const HyperLogLog& other);
+
+        /** Estimated number of distinct values added */
+        size_t estimate() const;
+
+    private:
+        unsigned precision;
+        std::vector<uint8_t> registers;
+    };
+
+    /** Tracks the most frequent values in a column using the SpaceSaving algorithm
+     *
+     *  At most `capacity` values are kept. Each reported count overestimates the
+     *  true count by no more than the accompanying error, and any value which
+     *  occurs more than n / capacity times is guaranteed to be tracked.
+     */
+    class TopKSketch {
+    public:
+        struct Entry {
+            std::string value;
+            size_t count; /**< Estimated number of occurrences */
+            size_t error; /**< Maximum overestimation of count */
+        };
+
+        TopKSketch(size_t capacity = 64) : capacity(capacity) {}
+
+        void add(csv::string_view item) { this->add(item, internals::hash_string(item)); }
+        void add(csv::string_view item, uint64_t hash);
+
+        /** Combine with a sketch built over another set of values */
+        void merge(const TopKSketch& other);
+
+        /** Tracked values, most frequent first */
+        std::vector<Entry> top() const;
+
+    private:
+        size_t capacity;
+
+        /** Min-heap on count, so the root is the eviction candidate */
+        std::vector<Entry> heap;
+        std::vector<uint64_t> heap_hashes;
+
+        /** Maps value hashes to their position in heap */
+        std::unordered_map<uint64_t, size_t> index;
+
+        void sift_down(size_t i);
+        void swap_entries(size_t i, size_t j);
+        size_t min_count() const {
+            return this->heap.size() < this->capacity || this->heap.empty() ? 0 : this->heap[0].count;
+        }
+    };
+
+    /** Estimates quantiles of a stream of numbers using a KLL sketch
+     *  (Karnin, Lang & Liberty)
+     *
+     *  Values are kept in a hierarchy of compactors. When a level fills up it is
+     *  sorted and every other value is promoted to the next level with twice the
+     *  weight. Memory is bounded by roughly 3k values and the rank error is
+     *  about 1.7 / k, i.e. under 1% for the default k of 200.
+     *
+     *  Sketches can be merged, e.g. across threads or files.
+     */
+    class QuantileSketch {
+    public:
+        QuantileSketch(size_t k = 200) : k(std::max(k, (size_t)8)) {}
+
+        void add(double x);
+
+        /** Combine with a sketch built over another set of values */
+        void merge(const QuantileSketch& other);
+
+        /** Number of values added */
+        size_t size() const noexcept { return this->n; }
+
+        /** Estimated value at the given rank in [0, 1] (NAN if empty) */
+        double quantile(double rank) const;
+        std::vector<double> quantiles(const std::vector<double>& ranks) const;
+
+    private:
+        size_t k;
+        size_t n = 0;
+        size_t retained = 0;
+        size_t retained_limit = 0; /**< Cached max_retained() for the current number of levels */
+        uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+        std::vector<std::vector<double>> levels;
+
+        size_t capacity(size_t level) const;
+        size_t max_retained() const;
+        void compress();
+        void compact(size_t level);
+    };
+
     /** Class for calculating statistics from CSV files and in-memory sources
      *
      *  **Example**
      *  \include programs/csv_stats.cpp
      *
+     *  @par Implementation
+     *  Rows are read in chunks which are split into contiguous row ranges, one
+     *  per worker of a persistent internals::WorkerPool. Each worker keeps its own
+     *  partial statistics for every column, and these are merged once the whole
+     *  source has been read. The next chunk is read while the current one is
+     *  being processed.
      */
     class CSVStat {
     public:
@@ -6451,6 +6856,14 @@ namespace csv {
         std::vector<long double> get_maxes() const;
         std::vector<FreqCount> get_counts() const;
         std::vector<TypeCount> get_dtypes() const;
+        std::vector<size_t> get_distinct() const;
+        std::vector<std::vector<long double>> get_quantiles(
+            const std::vector<double>& ranks = { 0.5, 0.9, 0.99 }) const;
+
+        /** Per-column sketches, e.g. for merging statistics over several files */
+        std::vector<HyperLogLog> get_distinct_sketches() const { return this->distinct; }
+        std::vector<TopKSketch> get_top_k_sketches() const { return this->top_k; }
+        std::vector<QuantileSketch> get_quantile_sketches() const { return this->quantiles; }
 
         std::vector<std::string> get_col_names() const {
             return this->reader.get_col_names();
@@ -6459,28 +6872,49 @@ namespace csv {
         CSVStat(csv::string_view filename, CSVFormat format = CSVFormat::guess_csv());
         CSVStat(std::stringstream& source, CSVFormat format = CSVFormat());
     private:
+        /** Statistics for one column over the rows seen by a single worker */
+        struct ColumnStat {
+            long double n = 0;
+            long double mean = 0;
+            long double m2 = 0; /**< Sum of squared differences from the mean */
+            long double min = NAN;
+            long double max = NAN;
+            HyperLogLog distinct;
+            TopKSketch top_k;
+            QuantileSketch quantiles;
+            TypeCount dtypes;
+
+            /** Combine with statistics over a disjoint set of rows */
+            void merge(const ColumnStat& other);
+        };
+
         // An array of rolling averages
         // Each index corresponds to the rolling mean for the column at said index
         std::vector<long double> rolling_means;
         std::vector<long double> rolling_vars;
         std::vector<long double> mins;
         std::vector<long double> maxes;
-        std::vector<FreqCount> counts;
+        std::vector<HyperLogLog> distinct;
+        std::vector<TopKSketch> top_k;
+        std::vector<QuantileSketch> quantiles;
         std::vector<TypeCount> dtypes;
         std::vector<long double> n;
 
         // Statistic calculators
-        void variance(const long double&, const size_t&);
-        void count(CSVField&, const size_t&);
-        void min_max(const long double&, const size_t&);
-        void dtype(CSVField&, const size_t&);
+        void variance(const long double&, ColumnStat&);
+        void count(CSVField&, ColumnStat&);
+        void min_max(const long double&, ColumnStat&);
+        void dtype(CSVField&, ColumnStat&);
 
         void calc();
-        void calc_chunk();
         void calc_worker(const size_t&);
 
+        /** Per-worker, per-column partial statistics */
+        std::vector<std::vector<ColumnStat>> partials;
+        VariableColumnPolicy variable_column_policy = VariableColumnPolicy::IGNORE_ROW;
+
         CSVReader reader;
-        std::deque<CSVRow> records = {};
+        std::vector<CSVRow> records = {};
     };
 }
 
@@ -6489,6 +6923,12 @@ namespace csv {
 #include <unordered_map>
 
 namespace csv {
+    /** Determines how get_file_info() finds the number of rows in a file */
+    enum class RowCountMode {
+        PARSE = 0, /**< Parse every row, dropping rows CSVReader would drop */
+        SCAN = 1   /**< Count line terminators on the memory map without tokenizing */
+    };
+
     /** Returned by get_file_info() */
     struct CSVFileInfo {
         std::string filename;               /**< Filename */
@@ -6511,7 +6951,9 @@ namespace csv {
     /** @name Utility Functions */
     ///@{
     std::unordered_map<std::string, DataType> csv_data_types(const std::string&);
-    CSVFileInfo get_file_info(const std::string& filename);
+    CSVFileInfo get_file_info(const std::string& filename, RowCountMode mode = RowCountMode::PARSE);
+    std::vector<CSVFileInfo> get_file_info(const std::vector<std::string>& filenames,
+        RowCountMode mode = RowCountMode::PARSE, size_t n_threads = 0);
     int get_col_pos(csv::string_view filename, csv::string_view col_name,
         const CSVFormat& format = CSVFormat::guess_csv());
     ///@}
@@ -6891,6 +7333,118 @@ namespace csv {
             return std::string(mmap.begin(), mmap.end());
         }
 
+        CSV_INLINE size_t count_newlines(const char* data, size_t length,
+            int quote_char, bool& needs_fallback) noexcept {
+            size_t count = 0;
+            size_t i = 0;
+
+#if defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+            const __m256i newline_mask = _mm256_set1_epi8('\n');
+            const __m256i cr_mask = _mm256_set1_epi8('\r');
+            const __m256i quote_mask = _mm256_set1_epi8((char)quote_char);
+            __m256i special = _mm256_setzero_si256();
+            for (; i + 32 <= length; i += 32) {
+                const __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+                count += __builtin_popcount((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline_mask)));
+                special = _mm256_or_si256(special, _mm256_cmpeq_epi8(block, cr_mask));
+                if (quote_char >= 0)
+                    special = _mm256_or_si256(special, _mm256_cmpeq_epi8(block, quote_mask));
+            }
+            if (_mm256_movemask_epi8(special)) needs_fallback = true;
+#elif defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+            const __m128i newline_mask = _mm_set1_epi8('\n');
+            const __m128i cr_mask = _mm_set1_epi8('\r');
+            const __m128i quote_mask = _mm_set1_epi8((char)quote_char);
+            __m128i special = _mm_setzero_si128();
+            for (; i + 16 <= length; i += 16) {
+                const __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+                count += __builtin_popcount((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline_mask)));
+                special = _mm_or_si128(special, _mm_cmpeq_epi8(block, cr_mask));
+                if (quote_char >= 0)
+                    special = _mm_or_si128(special, _mm_cmpeq_epi8(block, quote_mask));
+            }
+            if (_mm_movemask_epi8(special)) needs_fallback = true;
+#endif
+
+            for (; i < length; i++) {
+                const char ch = data[i];
+                count += (ch == '\n');
+                if (ch == '\r' || (quote_char >= 0 && ch == (char)quote_char))
+                    needs_fallback = true;
+            }
+
+            return count;
+        }
+
+        CSV_INLINE void count_rows_quoted(const char* data, size_t length,
+            int quote_char, RowScanState& state) noexcept {
+            for (size_t i = 0; i < length; i++) {
+                const char ch = data[i];
+
+                if (quote_char >= 0 && ch == (char)quote_char) {
+                    // An escaped quote ("") toggles twice and leaves the state unchanged
+                    state.quote_escape = !state.quote_escape;
+                    state.after_cr = false;
+                }
+                else if (state.quote_escape) {
+                    continue;
+                }
+                else if (ch == '\n') {
+                    // The LF of a CRLF pair was already counted with its CR
+                    if (!state.after_cr) state.rows++;
+                    state.after_cr = false;
+                }
+                else if (ch == '\r') {
+                    state.rows++;
+                    state.after_cr = true;
+                }
+                else {
+                    state.after_cr = false;
+                }
+            }
+
+            if (length > 0) state.last_char = data[length - 1];
+        }
+
+        CSV_INLINE size_t count_rows(csv::string_view filename, const CSVFormat& format) {
+            const size_t file_size = get_file_size(filename);
+            const int quote_char = format.is_quoting_enabled() ? (int)(unsigned char)format.get_quote_char() : -1;
+            RowScanState state;
+            bool use_fallback = false;
+
+            // Scan in windows so that huge files do not need one huge mapping
+            for (size_t pos = 0; pos < file_size; pos += ITERATION_CHUNK_SIZE) {
+                const size_t length = std::min(file_size - pos, ITERATION_CHUNK_SIZE);
+                std::error_code error;
+                auto mmap = mio::make_mmap_source(std::string(filename), pos, length, error);
+                if (error) {
+                    throw std::runtime_error("Cannot open file " + std::string(filename));
+                }
+
+                if (!use_fallback) {
+                    size_t newlines = count_newlines(mmap.data(), mmap.length(), quote_char, use_fallback);
+                    if (!use_fallback) {
+                        // No quotes or CRs have been seen yet, so the fast count is exact
+                        state.rows += newlines;
+                        state.last_char = mmap.data()[mmap.length() - 1];
+                        continue;
+                    }
+                }
+
+                count_rows_quoted(mmap.data(), mmap.length(), quote_char, state);
+            }
+
+            size_t rows = state.rows;
+
+            // Last record without a trailing line terminator
+            if (file_size > 0 && state.last_char != '\n' && state.last_char != '\r')
+                rows++;
+
+            // Rows up to and including the header are not data
+            const size_t header_rows = (size_t)(format.get_header() + 1);
+            return rows > header_rows ? rows - header_rows : 0;
+        }
+
 #ifdef _MSC_VER
 #pragma region IBasicCVParser
 #endif
@@ -6908,6 +7462,15 @@ namespace csv {
             _ws_flags = internals::make_ws_flags(
                 format.trim_chars.data(), format.trim_chars.size()
             );
+
+            _filters = format.filters;
+            _filter_cols.assign(_filters.size(), CSV_NOT_FOUND);
+            _header_row = format.header;
+
+            // Without a header row, filters refer to user supplied column names
+            if (!_filters.empty() && _header_row < 0) {
+                this->resolve_filters(col_names ? col_names->get_col_names() : std::vector<std::string>());
+            }
         }
 
         CSV_INLINE void IBasicCSVParser::end_feed() {
@@ -7062,9 +7625,82 @@ namespace csv {
 
         CSV_INLINE void IBasicCSVParser::push_row() {
             current_row.row_length = fields->size() - current_row.fields_start;
+
+            if (!this->_filters.empty()) {
+                const int row_index = (int)(this->_rows_seen++);
+
+                if (row_index == this->_header_row) {
+                    std::vector<std::string> header;
+                    for (size_t i = 0; i < current_row.row_length; i++)
+                        header.push_back(std::string(this->current_field(i, this->_filter_buffer)));
+
+                    this->resolve_filters(header);
+                }
+                else if (row_index > this->_header_row && !this->filter_row()) {
+                    // Drop the row along with its fields
+                    this->fields->truncate(current_row.fields_start);
+                    return;
+                }
+            }
+
             this->_records->push_back(std::move(current_row));
         }
 
+        CSV_INLINE csv::string_view IBasicCSVParser::current_field(size_t index, std::string& buffer) const {
+            auto& field = (*this->fields)[current_row.fields_start + index];
+            auto field_str = this->data_ptr->data.substr(current_row.data_start + field.start, field.length);
+
+            if (!field.has_double_quote)
+                return field_str;
+
+            // Same unescaping as CSVRow::get_field()
+            buffer.clear();
+            bool prev_ch_quote = false;
+            for (size_t i = 0; i < field_str.size(); i++) {
+                if (parse_flag(field_str[i]) == ParseFlags::QUOTE) {
+                    if (prev_ch_quote) {
+                        prev_ch_quote = false;
+                        continue;
+                    }
+                    else {
+                        prev_ch_quote = true;
+                    }
+                }
+
+                buffer += field_str[i];
+            }
+
+            return csv::string_view(buffer);
+        }
+
+        CSV_INLINE void IBasicCSVParser::resolve_filters(const std::vector<std::string>& col_names) {
+            for (size_t i = 0; i < this->_filters.size(); i++) {
+                auto& column = this->_filters[i].get_column();
+                auto it = std::find(col_names.begin(), col_names.end(), column);
+
+                if (it == col_names.end()) {
+                    this->_filter_cols[i] = CSV_NOT_FOUND;
+                    this->_filter_error = "Cannot filter on missing column " + column;
+                }
+                else {
+                    this->_filter_cols[i] = (int)(it - col_names.begin());
+                }
+            }
+        }
+
+        CSV_INLINE bool IBasicCSVParser::filter_row() {
+            for (size_t i = 0; i < this->_filters.size(); i++) {
+                const int col = this->_filter_cols[i];
+                if (col == CSV_NOT_FOUND || (size_t)col >= current_row.row_length)
+                    return false;
+
+                if (!this->_filters[i].matches(this->current_field((size_t)col, this->_filter_buffer)))
+                    return false;
+            }
+
+            return true;
+        }
+
         CSV_INLINE void IBasicCSVParser::reset_data_ptr() {
             this->data_ptr = std::make_shared<RawCSVData>();
             this->data_ptr->parse_flags = this->_parse_flags;
@@ -7195,6 +7831,24 @@ namespace csv {
         return *this;
     }
 
+    CSV_INLINE bool FieldFilter::matches(csv::string_view field) const {
+        switch (this->op) {
+        case Op::IN:
+            return this->values.find(std::string(field)) != this->values.end();
+        case Op::PREFIX:
+            return field.substr(0, this->lower.size()) == csv::string_view(this->lower);
+        case Op::RANGE:
+            return field >= csv::string_view(this->lower) && field < csv::string_view(this->upper);
+        default: {
+            long double value = 0;
+            if (internals::data_type(field, &value) < DataType::CSV_INT8)
+                return false;
+
+            return value >= this->num_lower && value <= this->num_upper;
+        }
+        }
+    }
+
     CSV_INLINE CSVFormat& CSVFormat::header_row(int row) {
         if (row < 0) this->variable_column_policy = VariableColumnPolicy::KEEP;
 
@@ -7571,6 +8225,7 @@ namespace csv {
             if (this->records->empty()) return this->end();
         }
 
+        this->_n_rows++;
         CSVReader::iterator ret(this, this->records->pop_front());
         return ret;
     }
@@ -8195,163 +8850,235 @@ namespace csv {
         return ret;
     }
 
-    /** Get counts for each column */
+    /** Get approximate counts of the most frequent values in each column
+     *
+     *  @see TopKSketch
+     */
     CSV_INLINE std::vector<CSVStat::FreqCount> CSVStat::get_counts() const {
         std::vector<FreqCount> ret;
         for (size_t i = 0; i < this->get_col_names().size(); i++) {
-            ret.push_back(this->counts[i]);
+            FreqCount col_counts;
+            for (auto& entry : this->top_k[i].top())
+                col_counts[entry.value] = entry.count;
+
+            ret.push_back(std::move(col_counts));
         }
         return ret;
     }
 
-    /** Get data type counts for each column */
-    CSV_INLINE std::vector<CSVStat::TypeCount> CSVStat::get_dtypes() const {
-        std::vector<TypeCount> ret;        
+    /** Get the estimated number of distinct values in each column
+     *
+     *  @see HyperLogLog
+     */
+    CSV_INLINE std::vector<size_t> CSVStat::get_distinct() const {
+        std::vector<size_t> ret;
         for (size_t i = 0; i < this->get_col_names().size(); i++) {
-            ret.push_back(this->dtypes[i]);
+            ret.push_back(this->distinct[i].estimate());
         }
         return ret;
     }
 
-    CSV_INLINE void CSVStat::calc_chunk() {
-        /** Only create stats counters the first time **/
-        if (dtypes.empty()) {
-            /** Go through all records and calculate specified statistics */
-            for (size_t i = 0; i < this->get_col_names().size(); i++) {
-                dtypes.push_back({});
-                counts.push_back({});
-                rolling_means.push_back(0);
-                rolling_vars.push_back(0);
-                mins.push_back(NAN);
-                maxes.push_back(NAN);
-                n.push_back(0);
-            }
+    /** Get estimated quantiles of each numeric column
+     *
+     *  @param[in] ranks Ranks in [0, 1], e.g. 0.5 for the median
+     *  @return One vector per column with a value per rank (NAN for columns
+     *          without numeric values)
+     *
+     *  @see QuantileSketch
+     */
+    CSV_INLINE std::vector<std::vector<long double>> CSVStat::get_quantiles(const std::vector<double>& ranks) const {
+        std::vector<std::vector<long double>> ret;
+        for (size_t i = 0; i < this->get_col_names().size(); i++) {
+            auto col_quantiles = this->quantiles[i].quantiles(ranks);
+            ret.push_back(std::vector<long double>(col_quantiles.begin(), col_quantiles.end()));
         }
+        return ret;
+    }
 
-        // Start threads
-        std::vector<std::thread> pool;
-        for (size_t i = 0; i < this->get_col_names().size(); i++)
-            pool.push_back(std::thread(&CSVStat::calc_worker, this, i));
-
-        // Block until done
-        for (auto& th : pool)
-            th.join();
-
-        this->records.clear();
+    /** Get data type counts for each column */
+    CSV_INLINE std::vector<CSVStat::TypeCount> CSVStat::get_dtypes() const {
+        std::vector<TypeCount> ret;        
+        for (size_t i = 0; i < this->get_col_names().size(); i++) {
+            ret.push_back(this->dtypes[i]);
+        }
+        return ret;
     }
 
     CSV_INLINE void CSVStat::calc() {
         constexpr size_t CALC_CHUNK_SIZE = 5000;
+        const size_t n_cols = this->get_col_names().size();
+        const size_t n_workers = std::max(std::thread::hardware_concurrency(), 1u);
 
-        for (auto& row : reader) {
-            this->records.push_back(std::move(row));
+        this->variable_column_policy = this->reader.get_format().get_variable_column_policy();
+        this->partials.assign(n_workers, std::vector<ColumnStat>(n_cols));
 
-            /** Chunk rows */
-            if (this->records.size() == CALC_CHUNK_SIZE) {
-                calc_chunk();
+        {
+            internals::WorkerPool pool(n_workers, [this](size_t worker) { this->calc_worker(worker); });
+            std::vector<CSVRow> next_records;
+            next_records.reserve(CALC_CHUNK_SIZE);
+
+            for (auto& row : reader) {
+                next_records.push_back(std::move(row));
+
+                /** Chunk rows, reading the next chunk while this one is processed */
+                if (next_records.size() == CALC_CHUNK_SIZE) {
+                    pool.wait();
+                    this->records.swap(next_records);
+                    next_records.clear();
+                    pool.start();
+                }
             }
+
+            pool.wait();
+            if (!next_records.empty()) {
+                this->records.swap(next_records);
+                pool.start();
+                pool.wait();
+            }
+
+            this->records.clear();
         }
 
-        if (!this->records.empty()) {
-          calc_chunk();
+        /** Merge partial statistics from every worker */
+        for (size_t i = 0; i < n_cols; i++) {
+            ColumnStat total;
+            for (auto& worker_stats : this->partials)
+                total.merge(worker_stats[i]);
+
+            rolling_means.push_back(total.mean);
+            rolling_vars.push_back(total.m2);
+            mins.push_back(total.min);
+            maxes.push_back(total.max);
+            n.push_back(total.n);
+            distinct.push_back(std::move(total.distinct));
+            top_k.push_back(std::move(total.top_k));
+            quantiles.push_back(std::move(total.quantiles));
+            dtypes.push_back(std::move(total.dtypes));
         }
+
+        this->partials.clear();
     }
 
-    CSV_INLINE void CSVStat::calc_worker(const size_t &i) {
-        /** Worker thread for CSVStat::calc() which calculates statistics for one column.
+    CSV_INLINE void CSVStat::calc_worker(const size_t &worker) {
+        /** Worker thread for CSVStat::calc() which calculates statistics for
+         *  one contiguous range of rows in the current chunk.
          * 
-         *  @param[in] i Column index
+         *  @param[in] worker Worker index
          */
 
-        auto current_record = this->records.begin();
+        auto& stats = this->partials[worker];
+        const size_t n_cols = stats.size();
+        const size_t begin = this->records.size() * worker / this->partials.size();
+        const size_t end = this->records.size() * (worker + 1) / this->partials.size();
 
-        for (size_t processed = 0; current_record != this->records.end(); processed++) {
-            if (current_record->size() == this->get_col_names().size()) {
-                auto current_field = (*current_record)[i];
+        for (size_t r = begin; r < end; r++) {
+            auto& current_record = this->records[r];
 
-                // Optimization: Don't count() if there's too many distinct values in the first 1000 rows
-                if (processed < 1000 || this->counts[i].size() <= 500)
-                    this->count(current_field, i);
+            if (current_record.size() == n_cols) {
+                for (size_t i = 0; i < n_cols; i++) {
+                    auto current_field = current_record[i];
+                    auto& stat = stats[i];
 
-                this->dtype(current_field, i);
+                    this->count(current_field, stat);
+                    this->dtype(current_field, stat);
 
-                // Numeric Stuff
-                if (current_field.is_num()) {
-                    long double x_n = current_field.get<long double>();
+                    // Numeric Stuff
+                    if (current_field.is_num()) {
+                        long double x_n = current_field.get<long double>();
 
-                    // This actually calculates mean AND variance
-                    this->variance(x_n, i);
-                    this->min_max(x_n, i);
+                        // This actually calculates mean AND variance
+                        this->variance(x_n, stat);
+                        this->min_max(x_n, stat);
+                        stat.quantiles.add((double)x_n);
+                    }
                 }
             }
-            else if (this->reader.get_format().get_variable_column_policy() == VariableColumnPolicy::THROW) {
-                throw std::runtime_error("Line has different length than the others " + internals::format_row(*current_record));
+            else if (this->variable_column_policy == VariableColumnPolicy::THROW) {
+                throw std::runtime_error("Line has different length than the others " + internals::format_row(current_record));
             }
+        }
+    }
 
-            ++current_record;
+    CSV_INLINE void CSVStat::ColumnStat::merge(const ColumnStat& other) {
+        /** Combine means and variances using the parallel form of
+         *  Welford's Algorithm (Chan et al.)
+         */
+        if (other.n > 0) {
+            const long double total_n = this->n + other.n;
+            const long double delta = other.mean - this->mean;
+
+            this->mean += delta * other.n / total_n;
+            this->m2 += other.m2 + delta * delta * this->n * other.n / total_n;
+            this->n = total_n;
+
+            if (std::isnan(this->min) || other.min < this->min)
+                this->min = other.min;
+            if (std::isnan(this->max) || other.max > this->max)
+                this->max = other.max;
         }
+
+        this->distinct.merge(other.distinct);
+        this->top_k.merge(other.top_k);
+        this->quantiles.merge(other.quantiles);
+        for (auto& item : other.dtypes)
+            this->dtypes[item.first] += item.second;
     }
 
-    CSV_INLINE void CSVStat::dtype(CSVField& data, const size_t &i) {
+    CSV_INLINE void CSVStat::dtype(CSVField& data, ColumnStat& stat) {
         /** Given a record update the type counter
          *  @param[in]  record Data observation
-         *  @param[out] i      The column index that should be updated
+         *  @param[out] stat   The column statistics that should be updated
          */
         
         auto type = data.type();
-        if (this->dtypes[i].find(type) !=
-            this->dtypes[i].end()) {
+        if (stat.dtypes.find(type) !=
+            stat.dtypes.end()) {
             // Increment count
-            this->dtypes[i][type]++;
+            stat.dtypes[type]++;
         } else {
             // Initialize count
-            this->dtypes[i].insert(std::make_pair(type, 1));
+            stat.dtypes.insert(std::make_pair(type, 1));
         }
     }
 
-    CSV_INLINE void CSVStat::count(CSVField& data, const size_t &i) {
-        /** Given a record update the frequency counter
+    CSV_INLINE void CSVStat::count(CSVField& data, ColumnStat& stat) {
+        /** Given a record update the distinct value and frequency sketches
          *  @param[in]  record Data observation
-         *  @param[out] i      The column index that should be updated
+         *  @param[out] stat   The column statistics that should be updated
          */
 
-        auto item = data.get<std::string>();
+        auto item = data.get<csv::string_view>();
+        const uint64_t hash = internals::hash_string(item);
 
-        if (this->counts[i].find(item) !=
-            this->counts[i].end()) {
-            // Increment count
-            this->counts[i][item]++;
-        } else {
-            // Initialize count
-            this->counts[i].insert(std::make_pair(item, 1));
-        }
+        stat.distinct.add_hash(hash);
+        stat.top_k.add(item, hash);
     }
 
-    CSV_INLINE void CSVStat::min_max(const long double &x_n, const size_t &i) {
+    CSV_INLINE void CSVStat::min_max(const long double &x_n, ColumnStat& stat) {
         /** Update current minimum and maximum
-         *  @param[in]  x_n Data observation
-         *  @param[out] i   The column index that should be updated
+         *  @param[in]  x_n  Data observation
+         *  @param[out] stat The column statistics that should be updated
          */
-        if (std::isnan(this->mins[i]))
-            this->mins[i] = x_n;
-        if (std::isnan(this->maxes[i]))
-            this->maxes[i] = x_n;
+        if (std::isnan(stat.min))
+            stat.min = x_n;
+        if (std::isnan(stat.max))
+            stat.max = x_n;
         
-        if (x_n < this->mins[i])
-            this->mins[i] = x_n;
-        else if (x_n > this->maxes[i])
-            this->maxes[i] = x_n;
+        if (x_n < stat.min)
+            stat.min = x_n;
+        else if (x_n > stat.max)
+            stat.max = x_n;
     }
 
-    CSV_INLINE void CSVStat::variance(const long double &x_n, const size_t &i) {
+    CSV_INLINE void CSVStat::variance(const long double &x_n, ColumnStat& stat) {
         /** Given a record update rolling mean and variance for all columns
          *  using Welford's Algorithm
-         *  @param[in]  x_n Data observation
-         *  @param[out] i   The column index that should be updated
+         *  @param[in]  x_n  Data observation
+         *  @param[out] stat The column statistics that should be updated
          */
-        long double& current_rolling_mean = this->rolling_means[i];
-        long double& current_rolling_var = this->rolling_vars[i];
-        long double& current_n = this->n[i];
+        long double& current_rolling_mean = stat.mean;
+        long double& current_rolling_var = stat.m2;
+        long double& current_n = stat.n;
         long double delta;
         long double delta2;
 
@@ -8367,6 +9094,292 @@ namespace csv {
         }
     }
 
+    CSV_INLINE HyperLogLog::HyperLogLog(unsigned precision) : precision(precision) {
+        if (precision < 4 || precision > 18)
+            throw std::runtime_error("HyperLogLog precision must be between 4 and 18.");
+
+        this->registers.assign((size_t)1 << precision, 0);
+    }
+
+    CSV_INLINE void HyperLogLog::add_hash(uint64_t hash) noexcept {
+        /** The first `precision` bits select a register, which keeps the
+         *  longest run of leading zeros seen in the remaining bits
+         */
+        const size_t reg = (size_t)(hash >> (64 - this->precision));
+        const uint64_t rest = hash << this->precision;
+        const uint8_t rank = (uint8_t)std::min(internals::leading_zeros(rest) + 1, 64 - (int)this->precision + 1);
+
+        if (rank > this->registers[reg])
+            this->registers[reg] = rank;
+    }
+
+    CSV_INLINE void HyperLogLog::merge(const HyperLogLog& other) {
+        if (other.precision != this->precision)
+            throw std::runtime_error("Cannot merge HyperLogLog sketches with different precisions.");
+
+        for (size_t i = 0; i < this->registers.size(); i++)
+            this->registers[i] = std::max(this->registers[i], other.registers[i]);
+    }
+
+    CSV_INLINE size_t HyperLogLog::estimate() const {
+        const long double m = (long double)this->registers.size();
+        const long double alpha = 0.7213 / (1 + 1.079 / m);
+
+        long double sum = 0;
+        size_t zeros = 0;
+        for (auto reg : this->registers) {
+            sum += std::ldexp((long double)1, -(int)reg);
+            zeros += (reg == 0);
+        }
+
+        long double estimate = alpha * m * m / sum;
+
+        // Small range correction: fall back to linear counting
+        if (estimate <= 2.5 * m && zeros > 0)
+            estimate = m * std::log(m / (long double)zeros);
+
+        return (size_t)(estimate + 0.5);
+    }
+
+    CSV_INLINE void TopKSketch::add(csv::string_view item, uint64_t hash) {
+        auto it = this->index.find(hash);
+        if (it != this->index.end()) {
+            this->heap[it->second].count++;
+            this->sift_down(it->second);
+            return;
+        }
+
+        if (this->capacity == 0) return;
+
+        if (this->heap.size() < this->capacity) {
+            this->heap.push_back({ std::string(item), 1, 0 });
+            this->heap_hashes.push_back(hash);
+            this->index[hash] = this->heap.size() - 1;
+
+            // New entries have the smallest possible count, sift up to the root
+            for (size_t i = this->heap.size() - 1; i > 0 && this->heap[(i - 1) / 2].count > this->heap[i].count; i = (i - 1) / 2)
+                this->swap_entries(i, (i - 1) / 2);
+            return;
+        }
+
+        // Replace the least frequent value, inheriting its count as error
+        Entry& root = this->heap[0];
+        this->index.erase(this->heap_hashes[0]);
+        root.value = std::string(item);
+        root.error = root.count;
+        root.count++;
+        this->heap_hashes[0] = hash;
+        this->index[hash] = 0;
+        this->sift_down(0);
+    }
+
+    CSV_INLINE void TopKSketch::merge(const TopKSketch& other) {
+        /** Mergeable SpaceSaving (Agarwal et al.): a value missing from a full
+         *  sketch may have occurred up to that sketch's minimum count times
+         */
+        const size_t this_min = this->min_count();
+        const size_t other_min = other.min_count();
+
+        std::unordered_map<uint64_t, std::pair<Entry, uint64_t>> combined;
+        for (size_t i = 0; i < this->heap.size(); i++) {
+            Entry entry = this->heap[i];
+            auto it = other.index.find(this->heap_hashes[i]);
+            if (it != other.index.end()) {
+                entry.count += other.heap[it->second].count;
+                entry.error += other.heap[it->second].error;
+            }
+            else {
+                entry.count += other_min;
+                entry.error += other_min;
+            }
+            combined[this->heap_hashes[i]] = std::make_pair(std::move(entry), this->heap_hashes[i]);
+        }
+
+        for (size_t i = 0; i < other.heap.size(); i++) {
+            if (this->index.find(other.heap_hashes[i]) != this->index.end()) continue;
+
+            Entry entry = other.heap[i];
+            entry.count += this_min;
+            entry.error += this_min;
+            combined[other.heap_hashes[i]] = std::make_pair(std::move(entry), other.heap_hashes[i]);
+        }
+
+        std::vector<std::pair<Entry, uint64_t>> entries;
+        for (auto& item : combined)
+            entries.push_back(std::move(item.second));
+
+        std::sort(entries.begin(), entries.end(),
+            [](const std::pair<Entry, uint64_t>& a, const std::pair<Entry, uint64_t>& b) {
+                return a.first.count > b.first.count;
+            });
+        if (entries.size() > this->capacity)
+            entries.resize(this->capacity);
+
+        // A list sorted in descending order read backwards is a valid min-heap
+        this->heap.clear();
+        this->heap_hashes.clear();
+        this->index.clear();
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+            this->index[it->second] = this->heap.size();
+            this->heap.push_back(std::move(it->first));
+            this->heap_hashes.push_back(it->second);
+        }
+    }
+
+    CSV_INLINE std::vector<TopKSketch::Entry> TopKSketch::top() const {
+        std::vector<Entry> ret = this->heap;
+        std::sort(ret.begin(), ret.end(), [](const Entry& a, const Entry& b) {
+            return a.count > b.count;
+        });
+        return ret;
+    }
+
+    CSV_INLINE void TopKSketch::sift_down(size_t i) {
+        while (true) {
+            size_t smallest = i;
+            const size_t left = 2 * i + 1, right = 2 * i + 2;
+
+            if (left < this->heap.size() && this->heap[left].count < this->heap[smallest].count)
+                smallest = left;
+            if (right < this->heap.size() && this->heap[right].count < this->heap[smallest].count)
+                smallest = right;
+            if (smallest == i) return;
+
+            this->swap_entries(i, smallest);
+            i = smallest;
+        }
+    }
+
+    CSV_INLINE void TopKSketch::swap_entries(size_t i, size_t j) {
+        std::swap(this->heap[i], this->heap[j]);
+        std::swap(this->heap_hashes[i], this->heap_hashes[j]);
+        this->index[this->heap_hashes[i]] = i;
+        this->index[this->heap_hashes[j]] = j;
+    }
+
+    CSV_INLINE void QuantileSketch::add(double x) {
+        if (this->levels.empty()) {
+            this->levels.push_back({});
+            this->retained_limit = this->max_retained();
+        }
+
+        this->levels[0].push_back(x);
+        this->n++;
+        this->retained++;
+
+        if (this->retained >= this->retained_limit)
+            this->compress();
+    }
+
+    CSV_INLINE void QuantileSketch::merge(const QuantileSketch& other) {
+        if (other.levels.size() > this->levels.size())
+            this->levels.resize(other.levels.size());
+
+        for (size_t h = 0; h < other.levels.size(); h++)
+            this->levels[h].insert(this->levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+
+        this->n += other.n;
+        this->retained += other.retained;
+        this->compress();
+    }
+
+    CSV_INLINE double QuantileSketch::quantile(double rank) const {
+        return this->quantiles({ rank })[0];
+    }
+
+    CSV_INLINE std::vector<double> QuantileSketch::quantiles(const std::vector<double>& ranks) const {
+        if (this->n == 0)
+            return std::vector<double>(ranks.size(), NAN);
+
+        // Each value at level h stands for 2^h values of the original stream
+        std::vector<std::pair<double, uint64_t>> weighted;
+        weighted.reserve(this->retained);
+        for (size_t h = 0; h < this->levels.size(); h++)
+            for (double x : this->levels[h])
+                weighted.push_back(std::make_pair(x, (uint64_t)1 << h));
+
+        std::sort(weighted.begin(), weighted.end());
+
+        uint64_t total_weight = 0;
+        for (auto& item : weighted)
+            total_weight += item.second;
+
+        std::vector<double> ret;
+        for (double rank : ranks) {
+            const double target = std::min(std::max(rank, 0.0), 1.0) * (double)total_weight;
+            uint64_t cumulative = 0;
+            double value = weighted.back().first;
+
+            for (auto& item : weighted) {
+                cumulative += item.second;
+                if ((double)cumulative >= target) {
+                    value = item.first;
+                    break;
+                }
+            }
+
+            ret.push_back(value);
+        }
+
+        return ret;
+    }
+
+    CSV_INLINE size_t QuantileSketch::capacity(size_t level) const {
+        /** Levels below the top shrink geometrically by a factor of 2/3 */
+        const size_t depth = this->levels.size() - level - 1;
+        return std::max((size_t)2, (size_t)std::ceil((double)this->k * std::pow(2.0 / 3.0, (double)depth)));
+    }
+
+    CSV_INLINE size_t QuantileSketch::max_retained() const {
+        size_t ret = 0;
+        for (size_t h = 0; h < this->levels.size(); h++)
+            ret += this->capacity(h);
+        return ret;
+    }
+
+    CSV_INLINE void QuantileSketch::compress() {
+        while (this->retained > 0 && this->retained >= this->max_retained()) {
+            for (size_t h = 0; h < this->levels.size(); h++) {
+                if (this->levels[h].size() >= this->capacity(h)) {
+                    this->compact(h);
+                    break;
+                }
+            }
+        }
+
+        this->retained_limit = this->max_retained();
+    }
+
+    CSV_INLINE void QuantileSketch::compact(size_t level) {
+        if (level + 1 == this->levels.size())
+            this->levels.push_back({});
+
+        auto& items = this->levels[level];
+        auto& next = this->levels[level + 1];
+        std::sort(items.begin(), items.end());
+
+        // Keep one value behind if the count is odd so that total weight is preserved
+        double leftover = NAN;
+        const bool odd = items.size() % 2 == 1;
+        if (odd) {
+            leftover = items.back();
+            items.pop_back();
+        }
+
+        // Promote the even or odd positioned values at random (xorshift64)
+        this->rng_state ^= this->rng_state << 13;
+        this->rng_state ^= this->rng_state >> 7;
+        this->rng_state ^= this->rng_state << 17;
+        const size_t offset = (size_t)(this->rng_state & 1);
+
+        for (size_t i = offset; i < items.size(); i += 2)
+            next.push_back(items[i]);
+
+        this->retained -= items.size() / 2;
+        items.clear();
+        if (odd) items.push_back(leftover);
+    }
+
     /** Useful for uploading CSV files to SQL databases.
      *
      *  Return a data type for each column such that every value in a column can be
@@ -8403,6 +9416,8 @@ namespace csv {
         return csv_dtypes;
     }
 }
+#include <atomic>
+#include <exception>
 #include <sstream>
 #include <vector>
 
@@ -8464,8 +9479,32 @@ namespace csv {
 
     /** Get basic information about a CSV file
      *  @include programs/csv_info.cpp
+     *
+     *  @param[in] filename Path to CSV file
+     *  @param[in] mode     With RowCountMode::SCAN only the head of the file is
+     *                      parsed and rows are counted by scanning for line terminators
      */
-    CSV_INLINE CSVFileInfo get_file_info(const std::string& filename) {
+    CSV_INLINE CSVFileInfo get_file_info(const std::string& filename, RowCountMode mode) {
+        if (mode == RowCountMode::SCAN) {
+            auto head = internals::get_csv_head(filename);
+            auto guess_result = internals::_guess_format(head, CSVFormat::guess_csv().get_possible_delims());
+
+            CSVFormat format = CSVFormat::guess_csv();
+            format.delimiter(guess_result.delim).header_row(guess_result.header_row);
+
+            auto col_names = internals::_get_col_names(head, format);
+
+            CSVFileInfo info = {
+                filename,
+                col_names,
+                format.get_delim(),
+                internals::count_rows(filename, format),
+                col_names.size()
+            };
+
+            return info;
+        }
+
         CSVReader reader(filename);
         CSVFormat format = reader.get_format();
         for (auto it = reader.begin(); it != reader.end(); ++it);
@@ -8480,6 +9519,48 @@ namespace csv {
 
         return info;
     }
+
+    /** Get basic information about several CSV files in parallel
+     *
+     *  @param[in] filenames Paths to CSV files
+     *  @param[in] mode      How rows should be counted, see get_file_info()
+     *  @param[in] n_threads Number of worker threads (0 = hardware concurrency)
+     *
+     *  @return One CSVFileInfo per file, in the same order as filenames
+     */
+    CSV_INLINE std::vector<CSVFileInfo> get_file_info(const std::vector<std::string>& filenames,
+        RowCountMode mode, size_t n_threads) {
+        std::vector<CSVFileInfo> ret(filenames.size());
+        std::vector<std::exception_ptr> errors(filenames.size());
+        std::atomic<size_t> next_file(0);
+
+        if (n_threads == 0)
+            n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        n_threads = std::min(n_threads, filenames.size());
+
+        auto worker = [&]() {
+            for (size_t i = next_file++; i < filenames.size(); i = next_file++) {
+                try {
+                    ret[i] = get_file_info(filenames[i], mode);
+                }
+                catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (size_t i = 0; i < n_threads; i++)
+            pool.push_back(std::thread(worker));
+
+        for (auto& th : pool)
+            th.join();
+
+        for (auto& error : errors)
+            if (error) std::rethrow_exception(error);
+
+        return ret;
+    }
 }
 
 
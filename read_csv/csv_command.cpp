@@ -5,6 +5,18 @@ CSVCommand::CSVCommand(const int argc, char **argv) : CommandParser(argc, argv)
     options_key[OptionKeyword::CSVFile] = "-i";
     options_key[OptionKeyword::GraphFile] = "-g";
     options_key[OptionKeyword::LabelFile] = "-l";
+    options_key[OptionKeyword::NeighborLabelOffset] = "-nlo";
+    options_key[OptionKeyword::VertexOrder] = "-order";
+    options_key[OptionKeyword::CompressedAdjacency] = "-svb";
+    options_key[OptionKeyword::RelationSegments] = "-rel";
+    options_key[OptionKeyword::IdMapping] = "-idmap";
+    options_key[OptionKeyword::IdOrder] = "-idorder";
+    options_key[OptionKeyword::NeighborLabelFrequency] = "-nlf";
+    options_key[OptionKeyword::GraphStatistics] = "-stats";
+    options_key[OptionKeyword::PartitionNum] = "-parts";
+    options_key[OptionKeyword::PartitionStrategy] = "-partition";
+    options_key[OptionKeyword::UpdateMode] = "-update";
+    options_key[OptionKeyword::CompactThreshold] = "-compact";
     processOptions();
 };
 
@@ -17,4 +29,40 @@ void CSVCommand::processOptions() {
 
     // Label file path
     options_value[OptionKeyword::LabelFile] = getCommandOption(options_key[OptionKeyword::LabelFile]);
+
+    // Neighbor-label offset sections
+    options_value[OptionKeyword::NeighborLabelOffset] = commandOptionExists(options_key[OptionKeyword::NeighborLabelOffset]) ? "true" : "false";
+
+    // Vertex reordering policy
+    options_value[OptionKeyword::VertexOrder] = getCommandOption(options_key[OptionKeyword::VertexOrder]);
+
+    // Compressed adjacency file
+    options_value[OptionKeyword::CompressedAdjacency] = commandOptionExists(options_key[OptionKeyword::CompressedAdjacency]) ? "true" : "false";
+
+    // Relation-partitioned adjacency file
+    options_value[OptionKeyword::RelationSegments] = commandOptionExists(options_key[OptionKeyword::RelationSegments]) ? "true" : "false";
+
+    // Raw id <-> vertex ID map file
+    options_value[OptionKeyword::IdMapping] = commandOptionExists(options_key[OptionKeyword::IdMapping]) ? "true" : "false";
+
+    // Initial vertex ID order
+    options_value[OptionKeyword::IdOrder] = getCommandOption(options_key[OptionKeyword::IdOrder]);
+
+    // Neighbor-label frequency sections
+    options_value[OptionKeyword::NeighborLabelFrequency] = commandOptionExists(options_key[OptionKeyword::NeighborLabelFrequency]) ? "true" : "false";
+
+    // Label-pair statistics file
+    options_value[OptionKeyword::GraphStatistics] = commandOptionExists(options_key[OptionKeyword::GraphStatistics]) ? "true" : "false";
+
+    // Number of partitions
+    options_value[OptionKeyword::PartitionNum] = getCommandOption(options_key[OptionKeyword::PartitionNum]);
+
+    // Partition policy
+    options_value[OptionKeyword::PartitionStrategy] = getCommandOption(options_key[OptionKeyword::PartitionStrategy]);
+
+    // Update mode
+    options_value[OptionKeyword::UpdateMode] = commandOptionExists(options_key[OptionKeyword::UpdateMode]) ? "true" : "false";
+
+    // Compaction threshold
+    options_value[OptionKeyword::CompactThreshold] = getCommandOption(options_key[OptionKeyword::CompactThreshold]);
 }
\ No newline at end of file
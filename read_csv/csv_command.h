@@ -1,14 +1,28 @@
 #ifndef CSV_COMMAND_H
 #define CSV_COMMAND_H
 
+#include "type.h"
 #include "utility/command_parser.h"
 #include <map>
+#include <cstdlib>
 #include <iostream>
 
 enum OptionKeyword {
     CSVFile = 1,     // -i, The csv file path, compulsive parameter
     GraphFile = 2,      // -g, The data graph file path, compulsive parameter
-    LabelFile = 3      // -l, The label file path, compulsive parameter
+    LabelFile = 3,      // -l, The label file path, compulsive parameter
+    NeighborLabelOffset = 4,      // -nlo, Append neighbor-label offset sections to the data graph, optional flag
+    VertexOrder = 5,      // -order, Vertex reordering policy (original, degree, rcm, gorder), optional parameter
+    CompressedAdjacency = 6,      // -svb, Also write StreamVByte-compressed adjacency to <graph>.svb, optional flag
+    RelationSegments = 7,      // -rel, Also write per-relation adjacency segments to <graph>.rel, optional flag
+    IdMapping = 8,      // -idmap, Also write the raw id <-> vertex ID map to <graph>.idmap, optional flag
+    IdOrder = 9,      // -idorder, Order of initial vertex IDs within a label (lexical, numeric, firstseen), optional parameter
+    NeighborLabelFrequency = 10,      // -nlf, Append neighbor-label frequency sections to the data graph, optional flag
+    GraphStatistics = 11,      // -stats, Also write label-pair statistics to <graph>.stats, optional flag
+    PartitionNum = 12,      // -parts, Number of partition files <graph>.part<i> to write, optional parameter
+    PartitionStrategy = 13,      // -partition, Partition policy (hash, range, label), optional parameter
+    UpdateMode = 14,      // -update, Apply the csv files as insertions to the existing graph, optional flag
+    CompactThreshold = 15      // -compact, Delta/base edge ratio which triggers compaction (default 0.1), optional parameter
 };
 
 class CSVCommand : public CommandParser{
@@ -35,6 +49,54 @@ public:
     std::string getLabelFilePath() {
         return options_value[OptionKeyword::LabelFile];
     }
+
+    bool getNeighborLabelOffset() {
+        return options_value[OptionKeyword::NeighborLabelOffset] == "true";
+    }
+
+    bool getNeighborLabelFrequency() {
+        return options_value[OptionKeyword::NeighborLabelFrequency] == "true";
+    }
+
+    std::string getReorderPolicy() {
+        return options_value[OptionKeyword::VertexOrder];
+    }
+
+    bool getCompressedAdjacency() {
+        return options_value[OptionKeyword::CompressedAdjacency] == "true";
+    }
+
+    bool getRelationSegments() {
+        return options_value[OptionKeyword::RelationSegments] == "true";
+    }
+
+    std::string getIdAssignment() {
+        return options_value[OptionKeyword::IdOrder];
+    }
+
+    bool getGraphStatistics() {
+        return options_value[OptionKeyword::GraphStatistics] == "true";
+    }
+
+    ui getPartitionNum() {
+        return std::strtoul(options_value[OptionKeyword::PartitionNum].c_str(), nullptr, 10);
+    }
+
+    std::string getPartitionPolicy() {
+        return options_value[OptionKeyword::PartitionStrategy];
+    }
+
+    bool getUpdateMode() {
+        return options_value[OptionKeyword::UpdateMode] == "true";
+    }
+
+    double getCompactThreshold() {
+        return options_value[OptionKeyword::CompactThreshold].empty() ? 0.1 : std::strtod(options_value[OptionKeyword::CompactThreshold].c_str(), nullptr);
+    }
+
+    bool getIdMapping() {
+        return options_value[OptionKeyword::IdMapping] == "true";
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include "graph_codec.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+namespace {
+    inline ui byteLength(ui value) {
+        if (value < (1U << 8)) return 1;
+        if (value < (1U << 16)) return 2;
+        if (value < (1U << 24)) return 3;
+        return 4;
+    }
+
+    // shuffle masks and data lengths for every control byte
+    struct DecodeTable {
+        uint8_t shuffle[256][16];
+        uint8_t length[256];
+
+        DecodeTable() {
+            for (ui control = 0; control < 256; control++) {
+                ui position = 0;
+                for (ui lane = 0; lane < 4; lane++) {
+                    ui bytes = ((control >> (2 * lane)) & 3) + 1;
+                    for (ui byte = 0; byte < 4; byte++) {
+                        shuffle[control][lane * 4 + byte] = byte < bytes ? position++ : 0xFF;
+                    }
+                }
+                length[control] = position;
+            }
+        }
+    };
+
+    const DecodeTable& decodeTable() {
+        static const DecodeTable table;
+        return table;
+    }
+
+    /*
+     * Decode one group of four gaps into absolute values starting from base.
+     * Returns the number of data bytes consumed.
+     */
+    inline ui decodeGroup(uint8_t control, const uint8_t* data, VertexID base, VertexID* out) {
+        const DecodeTable &table = decodeTable();
+#ifdef __SSSE3__
+        __m128i gaps = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data),
+                                        _mm_loadu_si128((const __m128i*)table.shuffle[control]));
+        gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 4));
+        gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 8));
+        _mm_storeu_si128((__m128i*)out, _mm_add_epi32(gaps, _mm_set1_epi32(base)));
+#else
+        const uint8_t* p = data;
+        for (ui lane = 0; lane < 4; lane++) {
+            ui bytes = ((control >> (2 * lane)) & 3) + 1;
+            ui gap = 0;
+            std::memcpy(&gap, p, bytes);
+            p += bytes;
+            base += gap;
+            out[lane] = base;
+        }
+#endif
+        return table.length[control];
+    }
+
+    // Decode the last, partial group of a block
+    inline void decodeTail(uint8_t control, const uint8_t* data, ui count, VertexID base, VertexID* out) {
+        for (ui lane = 0; lane < count; lane++) {
+            ui bytes = ((control >> (2 * lane)) & 3) + 1;
+            ui gap = 0;
+            std::memcpy(&gap, data, bytes);
+            data += bytes;
+            base += gap;
+            out[lane] = base;
+        }
+    }
+
+    // Decode a block of count values, returns a pointer past its last byte
+    const uint8_t* decodeBlock(const uint8_t* block, ui count, VertexID base, VertexID* out) {
+        const uint8_t* control = block;
+        const uint8_t* data = block + (count + 3) / 4;
+        ui full_groups = count / 4;
+        for (ui group = 0; group < full_groups; group++) {
+            data += decodeGroup(control[group], data, base, out);
+            base = out[3];
+            out += 4;
+        }
+        if (count % 4 != 0) {
+            uint8_t tail_control = control[full_groups];
+            decodeTail(tail_control, data, count % 4, base, out);
+            for (ui lane = 0; lane < count % 4; lane++) {
+                data += ((tail_control >> (2 * lane)) & 3) + 1;
+            }
+        }
+        return data;
+    }
+
+    void encodeBlock(const VertexID* values, ui count, VertexID base, std::vector<uint8_t> &data) {
+        size_t control_start = data.size();
+        data.resize(control_start + (count + 3) / 4, 0);
+        for (ui i = 0; i < count; i++) {
+            ui gap = values[i] - base;
+            base = values[i];
+            ui bytes = byteLength(gap);
+            data[control_start + i / 4] |= (uint8_t)((bytes - 1) << (2 * (i % 4)));
+            for (ui byte = 0; byte < bytes; byte++) {
+                data.push_back((uint8_t)(gap >> (8 * byte)));
+            }
+        }
+    }
+}
+
+void encodeNeighbors(const VertexID* neighbors, ui degree, ui block_size,
+                     std::vector<uint8_t> &data, std::vector<SkipEntry> &skips) {
+    size_t list_start = data.size();
+    for (ui start = 0; start < degree; start += block_size) {
+        ui count = std::min(block_size, degree - start);
+        VertexID base = 0;
+        if (start != 0) {
+            base = neighbors[start - 1];
+            skips.push_back({base, (ui)(data.size() - list_start)});
+        }
+        encodeBlock(neighbors + start, count, base, data);
+    }
+}
+
+uint64_t encodedSize(const uint8_t* data, ui degree, ui block_size) {
+    const DecodeTable &table = decodeTable();
+    uint64_t size = 0;
+    for (ui start = 0; start < degree; start += block_size) {
+        ui count = std::min(block_size, degree - start);
+        ui control_num = (count + 3) / 4;
+        // a partial last group has zero bits for its missing lanes, counted as one byte each
+        ui missing = control_num * 4 - count;
+        uint64_t block_size_in_bytes = control_num;
+        for (ui i = 0; i < control_num; i++) {
+            block_size_in_bytes += table.length[data[size + i]];
+        }
+        block_size_in_bytes -= missing;
+        size += block_size_in_bytes;
+    }
+    return size;
+}
+
+void decodeNeighbors(const uint8_t* data, ui degree, ui block_size, VertexID* out) {
+    for (ui start = 0; start < degree; start += block_size) {
+        ui count = std::min(block_size, degree - start);
+        VertexID base = start == 0 ? 0 : out[start - 1];
+        data = decodeBlock(data, count, base, out + start);
+    }
+}
+
+bool containsNeighbor(const uint8_t* data, const SkipEntry* skips, ui degree, ui block_size, VertexID target) {
+    if (degree == 0) {
+        return false;
+    }
+    // block b holds the values in (skips[b - 1].base, skips[b].base]
+    ui block_num = (degree + block_size - 1) / block_size;
+    ui block = std::lower_bound(skips, skips + block_num - 1, target,
+                                [](const SkipEntry &entry, VertexID value) { return entry.base < value; }) - skips;
+    VertexID base = 0;
+    if (block != 0) {
+        base = skips[block - 1].base;
+        data += skips[block - 1].byte_offset;
+    }
+    ui count = std::min(block_size, degree - block * block_size);
+
+    const uint8_t* control = data;
+    const uint8_t* group_data = data + (count + 3) / 4;
+    VertexID values[4];
+    for (ui start = 0; start < count; start += 4) {
+        ui group_count = std::min(4U, count - start);
+        if (group_count == 4) {
+            group_data += decodeGroup(control[start / 4], group_data, base, values);
+        } else {
+            decodeTail(control[start / 4], group_data, group_count, base, values);
+        }
+        if (values[group_count - 1] >= target) {
+            for (ui lane = 0; lane < group_count; lane++) {
+                if (values[lane] == target) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        base = values[3];
+    }
+    return false;
+}
+
+static void writeDirection(std::ofstream &descriptor, ui vertex_num, const ui* degree, VertexID** neighbors_array) {
+    std::vector<SkipEntry> skips;
+    std::vector<uint8_t> data;
+
+    for (ui i = 0; i < vertex_num; i++) {
+        encodeNeighbors(neighbors_array[i], degree[i], SVB_BLOCK_SIZE, data, skips);
+    }
+    uint64_t skip_num = skips.size();
+    uint64_t data_size = data.size();
+    data.resize(data.size() + SVB_PADDING, 0);
+
+    descriptor.write((char*)&skip_num, sizeof(uint64_t));
+    descriptor.write((char*)skips.data(), sizeof(SkipEntry) * skip_num);
+    descriptor.write((char*)&data_size, sizeof(uint64_t));
+    descriptor.write((char*)data.data(), sizeof(uint8_t) * data.size());
+}
+
+void writeCompressedGraph(const std::string &file_path, ui vertex_num, ui size_vertex_num_offset,
+                          const ui* vertex_num_offset, const ui* in_degree, const ui* out_degree,
+                          VertexID** in_neighbors_array, VertexID** out_neighbors_array) {
+    std::ofstream descriptor(file_path, std::ios::binary);
+
+    ui magic = SVB_MAGIC;
+    ui block_size = SVB_BLOCK_SIZE;
+    descriptor.write((char*)&magic, sizeof(ui));
+    descriptor.write((char*)&block_size, sizeof(ui));
+    descriptor.write((char*)&vertex_num, sizeof(ui));
+    descriptor.write((char*)&size_vertex_num_offset, sizeof(ui));
+    descriptor.write((char*)vertex_num_offset, sizeof(ui) * size_vertex_num_offset);
+    descriptor.write((char*)in_degree, sizeof(ui) * vertex_num);
+    descriptor.write((char*)out_degree, sizeof(ui) * vertex_num);
+
+    writeDirection(descriptor, vertex_num, in_degree, in_neighbors_array);
+    writeDirection(descriptor, vertex_num, out_degree, out_neighbors_array);
+
+    descriptor.close();
+}
+
+template <typename T>
+static void readArray(std::ifstream &descriptor, std::vector<T> &values, size_t count) {
+    values.resize(count);
+    descriptor.read((char*)values.data(), sizeof(T) * count);
+}
+
+bool CompressedGraph::load(const std::string &file_path) {
+    std::ifstream descriptor(file_path, std::ios::binary);
+    if (!descriptor.is_open()) {
+        std::cout << "wrong path!" << std::endl;
+        return false;
+    }
+
+    ui magic = 0;
+    descriptor.read((char*)&magic, sizeof(ui));
+    if (magic != SVB_MAGIC) {
+        std::cout << "not a compressed graph file!" << std::endl;
+        return false;
+    }
+
+    ui size_vertex_num_offset = 0;
+    descriptor.read((char*)&block_size, sizeof(ui));
+    descriptor.read((char*)&vertex_num, sizeof(ui));
+    descriptor.read((char*)&size_vertex_num_offset, sizeof(ui));
+    readArray(descriptor, vertex_num_offset, size_vertex_num_offset);
+    readArray(descriptor, in_degree, vertex_num);
+    readArray(descriptor, out_degree, vertex_num);
+
+    Direction* directions[2] = {&in, &out};
+    const std::vector<ui>* degrees[2] = {&in_degree, &out_degree};
+    for (ui d = 0; d < 2; d++) {
+        Direction* direction = directions[d];
+        const std::vector<ui> &degree = *degrees[d];
+        uint64_t skip_num = 0;
+        uint64_t data_size = 0;
+        descriptor.read((char*)&skip_num, sizeof(uint64_t));
+        readArray(descriptor, direction->skips, skip_num);
+        descriptor.read((char*)&data_size, sizeof(uint64_t));
+        readArray(descriptor, direction->data, data_size + SVB_PADDING);
+        if (!descriptor) {
+            std::cout << "truncated compressed graph file!" << std::endl;
+            return false;
+        }
+
+        direction->list_offset.resize(vertex_num + 1);
+        direction->skip_offset.resize(vertex_num + 1);
+        direction->list_offset[0] = 0;
+        direction->skip_offset[0] = 0;
+        for (ui i = 0; i < vertex_num; i++) {
+            direction->list_offset[i + 1] = direction->list_offset[i] +
+                    encodedSize(direction->data.data() + direction->list_offset[i], degree[i], block_size);
+            direction->skip_offset[i + 1] = direction->skip_offset[i] + (degree[i] == 0 ? 0 : (degree[i] - 1) / block_size);
+        }
+        if (direction->list_offset[vertex_num] != data_size || direction->skip_offset[vertex_num] != skip_num) {
+            std::cout << "corrupted compressed graph file!" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void CompressedGraph::getInNeighbors(VertexID v, VertexID* neighbors) const {
+    decodeNeighbors(in.data.data() + in.list_offset[v], in_degree[v], block_size, neighbors);
+}
+
+void CompressedGraph::getOutNeighbors(VertexID v, VertexID* neighbors) const {
+    decodeNeighbors(out.data.data() + out.list_offset[v], out_degree[v], block_size, neighbors);
+}
+
+bool CompressedGraph::hasEdge(VertexID u, VertexID v) const {
+    return containsNeighbor(out.data.data() + out.list_offset[u], out.skips.data() + out.skip_offset[u],
+                            out_degree[u], block_size, v);
+}
@@ -0,0 +1,94 @@
+#ifndef GRAPH_CODEC_H
+#define GRAPH_CODEC_H
+
+#include "type.h"
+#include <string>
+#include <vector>
+
+/*
+ * Compressed adjacency file (<graph>.svb).
+ *
+ * Neighbor lists are sorted, so each list is stored as delta gaps packed with
+ * StreamVByte: values are grouped by four, one control byte holds the 2-bit
+ * byte lengths of a group and the data bytes follow the control bytes. Every
+ * list is cut into blocks of block_size neighbors, each block encoded on its own
+ * as [control bytes][data bytes] with gaps starting from the block base. Blocks
+ * after the first get a skip entry (base, byte offset in the list), where the
+ * base is the last neighbor of the previous block, so a lookup only decodes the
+ * one block that may contain the target.
+ *
+ * Layout:
+ *   ui magic, ui block_size, ui vertex_num, ui size_vertex_num_offset,
+ *   ui vertex_num_offset[size_vertex_num_offset], ui in_degree[vertex_num], ui out_degree[vertex_num],
+ *   in-neighbor lists, out-neighbor lists, each as
+ *     uint64_t skip_num, SkipEntry skips[skip_num], uint64_t data_size, uint8_t data[data_size + SVB_PADDING]
+ * Lists are stored back to back in vertex order. A list of degree d has
+ * (d - 1) / block_size skip entries, and its encoded size follows from its
+ * control bytes, so loaders rebuild per-vertex offsets in one pass instead of
+ * storing them. The data area is padded so the decoder may always load 16 bytes at once.
+ */
+#define SVB_MAGIC 0x31425653    // "SVB1"
+#define SVB_BLOCK_SIZE 128
+#define SVB_PADDING 16
+
+struct SkipEntry {
+    VertexID base;          // last neighbor of the previous block
+    ui byte_offset;         // start of the block relative to the start of the list
+};
+
+// Append the encoding of a sorted neighbor list to data and its skip entries to skips
+void encodeNeighbors(const VertexID* neighbors, ui degree, ui block_size,
+                     std::vector<uint8_t> &data, std::vector<SkipEntry> &skips);
+
+// Size in bytes of an encoded list, computed from its control bytes
+uint64_t encodedSize(const uint8_t* data, ui degree, ui block_size);
+
+// Decode a whole list, out must hold degree values
+void decodeNeighbors(const uint8_t* data, ui degree, ui block_size, VertexID* out);
+
+// Membership test using the skip entries of the list
+bool containsNeighbor(const uint8_t* data, const SkipEntry* skips, ui degree, ui block_size, VertexID target);
+
+void writeCompressedGraph(const std::string &file_path, ui vertex_num, ui size_vertex_num_offset,
+                          const ui* vertex_num_offset, const ui* in_degree, const ui* out_degree,
+                          VertexID** in_neighbors_array, VertexID** out_neighbors_array);
+
+/*
+ * In-memory view of a .svb file, for loaders which keep the graph compressed
+ * and decode neighbor lists on demand.
+ */
+class CompressedGraph {
+private:
+    struct Direction {
+        std::vector<uint64_t> list_offset;
+        std::vector<uint64_t> skip_offset;
+        std::vector<SkipEntry> skips;
+        std::vector<uint8_t> data;
+    };
+
+    ui block_size;
+    ui vertex_num;
+    std::vector<ui> vertex_num_offset;
+    std::vector<ui> in_degree;
+    std::vector<ui> out_degree;
+    Direction in;
+    Direction out;
+
+public:
+    CompressedGraph() : block_size(SVB_BLOCK_SIZE), vertex_num(0) {}
+
+    bool load(const std::string &file_path);
+
+    ui getVertexNum() const { return vertex_num; }
+    const std::vector<ui>& getVertexNumOffset() const { return vertex_num_offset; }
+    ui getInDegree(VertexID v) const { return in_degree[v]; }
+    ui getOutDegree(VertexID v) const { return out_degree[v]; }
+
+    // out must hold getInDegree(v) / getOutDegree(v) values
+    void getInNeighbors(VertexID v, VertexID* neighbors) const;
+    void getOutNeighbors(VertexID v, VertexID* neighbors) const;
+
+    bool hasEdge(VertexID u, VertexID v) const;
+};
+
+#endif
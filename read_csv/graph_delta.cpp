@@ -0,0 +1,472 @@
+#include "graph_delta.h"
+#include "csv.hpp"
+#include "id_map.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/file.h>
+#include <unistd.h>
+#include <unordered_map>
+
+bool GraphDelta::load(const std::string &file_path) {
+    std::ifstream descriptor(file_path, std::ios::binary);
+    if (!descriptor.is_open()) {
+        return false;
+    }
+
+    ui magic = 0;
+    ui new_vertex_num = 0;
+    uint64_t edge_num = 0;
+    descriptor.read((char*)&magic, sizeof(ui));
+    if (magic != GRAPH_DELTA_MAGIC) {
+        std::cout << "not a delta file!" << std::endl;
+        return false;
+    }
+    descriptor.read((char*)&base_vertex_num, sizeof(ui));
+    descriptor.read((char*)&base_edge_num, sizeof(uint64_t));
+    descriptor.read((char*)&new_vertex_num, sizeof(ui));
+    new_vertex_label.resize(new_vertex_num);
+    new_vertex_raw_id.resize(new_vertex_num);
+    descriptor.read((char*)new_vertex_label.data(), sizeof(LabelID) * new_vertex_num);
+    descriptor.read((char*)new_vertex_raw_id.data(), sizeof(uint64_t) * new_vertex_num);
+    descriptor.read((char*)&edge_num, sizeof(uint64_t));
+    edges.resize(edge_num);
+    descriptor.read((char*)edges.data(), sizeof(std::pair<VertexID, VertexID>) * edge_num);
+
+    if (!descriptor) {
+        std::cout << "truncated delta file!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool GraphDelta::save(const std::string &file_path) const {
+    std::string tmp_file = file_path + ".tmp";
+    std::ofstream descriptor(tmp_file, std::ios::binary);
+
+    ui magic = GRAPH_DELTA_MAGIC;
+    ui new_vertex_num = new_vertex_label.size();
+    uint64_t edge_num = edges.size();
+    descriptor.write((char*)&magic, sizeof(ui));
+    descriptor.write((char*)&base_vertex_num, sizeof(ui));
+    descriptor.write((char*)&base_edge_num, sizeof(uint64_t));
+    descriptor.write((char*)&new_vertex_num, sizeof(ui));
+    descriptor.write((char*)new_vertex_label.data(), sizeof(LabelID) * new_vertex_num);
+    descriptor.write((char*)new_vertex_raw_id.data(), sizeof(uint64_t) * new_vertex_num);
+    descriptor.write((char*)&edge_num, sizeof(uint64_t));
+    descriptor.write((char*)edges.data(), sizeof(std::pair<VertexID, VertexID>) * edge_num);
+
+    descriptor.close();
+    if (descriptor.fail() || std::rename(tmp_file.c_str(), file_path.c_str()) != 0) {
+        std::cout << "cannot write delta file " << file_path << ", updates are not applied!" << std::endl;
+        std::remove(tmp_file.c_str());
+        return false;
+    }
+    return true;
+}
+
+static std::vector<std::string> readLabels(const std::string &label_file) {
+    std::vector<std::string> labels;
+    std::ifstream descriptor(label_file, std::ios::binary);
+    if (!descriptor.is_open()) {
+        std::cout << "wrong path!" << std::endl;
+        return labels;
+    }
+
+    ui label_num = 0;
+    descriptor.read((char*)&label_num, sizeof(ui));
+    std::vector<ui> label_offset(label_num + 1);
+    descriptor.read((char*)label_offset.data(), sizeof(ui) * (label_num + 1));
+    std::string names(label_offset[label_num], '\0');
+    descriptor.read(&names[0], label_offset[label_num]);
+    for (ui i = 0; i < label_num; i++) {
+        labels.push_back(names.substr(label_offset[i], label_offset[i + 1] - label_offset[i]));
+    }
+    return labels;
+}
+
+// Fixed layout of a data graph file, optional sections are not read
+struct BaseGraph {
+    ui vertex_num;
+    std::vector<ui> vertex_num_offset;
+    std::vector<ui> in_degree;
+    std::vector<ui> out_degree;
+    std::vector<VertexID> in_neighbors;
+    std::vector<VertexID> out_neighbors;
+
+    bool load(const std::string &file_path, bool with_neighbors) {
+        std::ifstream descriptor(file_path, std::ios::binary);
+        if (!descriptor.is_open()) {
+            std::cout << "wrong path!" << std::endl;
+            return false;
+        }
+        ui size_vertex_num_offset = 0;
+        descriptor.read((char*)&vertex_num, sizeof(ui));
+        descriptor.read((char*)&size_vertex_num_offset, sizeof(ui));
+        vertex_num_offset.resize(size_vertex_num_offset);
+        in_degree.resize(vertex_num);
+        out_degree.resize(vertex_num);
+        descriptor.read((char*)vertex_num_offset.data(), sizeof(ui) * size_vertex_num_offset);
+        descriptor.read((char*)in_degree.data(), sizeof(ui) * vertex_num);
+        descriptor.read((char*)out_degree.data(), sizeof(ui) * vertex_num);
+        if (with_neighbors) {
+            in_neighbors.resize(edgeNum(in_degree));
+            out_neighbors.resize(edgeNum(out_degree));
+            descriptor.read((char*)in_neighbors.data(), sizeof(VertexID) * in_neighbors.size());
+            descriptor.read((char*)out_neighbors.data(), sizeof(VertexID) * out_neighbors.size());
+        }
+        return (bool)descriptor;
+    }
+
+    static uint64_t edgeNum(const std::vector<ui> &degree) {
+        uint64_t edge_num = 0;
+        for (auto d : degree) {
+            edge_num += d;
+        }
+        return edge_num;
+    }
+};
+
+bool compactGraph(const std::string &graph_file, const GraphDelta &delta) {
+    BaseGraph base;
+    IdMap id_map;
+    if (!base.load(graph_file, true) || !id_map.load(graph_file + ".idmap")) {
+        std::cout << "compaction aborted!" << std::endl;
+        return false;
+    }
+    ui label_num = base.vertex_num_offset.size() - 1;
+
+    // new vertices go to the end of their label range
+    std::vector<ui> new_vertex_count(label_num, 0);
+    std::vector<ui> new_vertex_rank(delta.new_vertex_label.size());
+    for (ui i = 0; i < delta.new_vertex_label.size(); i++) {
+        new_vertex_rank[i] = new_vertex_count[delta.new_vertex_label[i]]++;
+    }
+    std::vector<ui> vertex_num_offset(label_num + 1);
+    vertex_num_offset[0] = 0;
+    for (ui label = 0; label < label_num; label++) {
+        vertex_num_offset[label + 1] = vertex_num_offset[label] + (base.vertex_num_offset[label + 1] - base.vertex_num_offset[label])
+                                       + new_vertex_count[label];
+    }
+    ui vertex_num = vertex_num_offset[label_num];
+
+    std::vector<VertexID> compact_id(base.vertex_num + delta.new_vertex_label.size());
+    for (ui label = 0; label < label_num; label++) {
+        for (VertexID v = base.vertex_num_offset[label]; v < base.vertex_num_offset[label + 1]; v++) {
+            compact_id[v] = v - base.vertex_num_offset[label] + vertex_num_offset[label];
+        }
+    }
+    for (ui i = 0; i < delta.new_vertex_label.size(); i++) {
+        LabelID label = delta.new_vertex_label[i];
+        compact_id[base.vertex_num + i] = vertex_num_offset[label + 1] - new_vertex_count[label] + new_vertex_rank[i];
+    }
+
+    // the remapping keeps relative order, so base lists stay sorted
+    std::vector<std::vector<VertexID> > in_neighbors(vertex_num);
+    std::vector<std::vector<VertexID> > out_neighbors(vertex_num);
+    uint64_t in_position = 0;
+    uint64_t out_position = 0;
+    for (VertexID v = 0; v < base.vertex_num; v++) {
+        std::vector<VertexID> &in_list = in_neighbors[compact_id[v]];
+        std::vector<VertexID> &out_list = out_neighbors[compact_id[v]];
+        for (ui j = 0; j < base.in_degree[v]; j++) {
+            in_list.push_back(compact_id[base.in_neighbors[in_position++]]);
+        }
+        for (ui j = 0; j < base.out_degree[v]; j++) {
+            out_list.push_back(compact_id[base.out_neighbors[out_position++]]);
+        }
+    }
+    std::vector<bool> touched(vertex_num, false);
+    for (auto const& edge : delta.edges) {
+        VertexID src = compact_id[edge.first];
+        VertexID dest = compact_id[edge.second];
+        out_neighbors[src].push_back(dest);
+        in_neighbors[dest].push_back(src);
+        touched[src] = true;
+        touched[dest] = true;
+    }
+    for (ui i = 0; i < vertex_num; i++) {
+        if (touched[i]) {
+            std::sort(in_neighbors[i].begin(), in_neighbors[i].end());
+            in_neighbors[i].erase(std::unique(in_neighbors[i].begin(), in_neighbors[i].end()), in_neighbors[i].end());
+            std::sort(out_neighbors[i].begin(), out_neighbors[i].end());
+            out_neighbors[i].erase(std::unique(out_neighbors[i].begin(), out_neighbors[i].end()), out_neighbors[i].end());
+        }
+    }
+
+    std::string graph_tmp_file = graph_file + ".tmp";
+    std::string id_map_tmp_file = graph_file + ".idmap.tmp";
+    std::ofstream graph_descriptor(graph_tmp_file, std::ios::binary);
+
+    ui size_vertex_num_offset = label_num + 1;
+    graph_descriptor.write((char*)&vertex_num, sizeof(ui));
+    graph_descriptor.write((char*)&size_vertex_num_offset, sizeof(ui));
+    graph_descriptor.write((char*)vertex_num_offset.data(), sizeof(ui) * size_vertex_num_offset);
+    std::vector<ui> in_degree(vertex_num);
+    std::vector<ui> out_degree(vertex_num);
+    for (ui i = 0; i < vertex_num; i++) {
+        in_degree[i] = in_neighbors[i].size();
+        out_degree[i] = out_neighbors[i].size();
+    }
+    graph_descriptor.write((char*)in_degree.data(), sizeof(ui) * vertex_num);
+    graph_descriptor.write((char*)out_degree.data(), sizeof(ui) * vertex_num);
+    for (ui i = 0; i < vertex_num; i++) {
+        graph_descriptor.write((char*)in_neighbors[i].data(), sizeof(VertexID) * in_degree[i]);
+    }
+    for (ui i = 0; i < vertex_num; i++) {
+        graph_descriptor.write((char*)out_neighbors[i].data(), sizeof(VertexID) * out_degree[i]);
+    }
+
+    graph_descriptor.close();
+    if (graph_descriptor.fail()) {
+        std::cout << "cannot write the compacted graph, compaction aborted!" << std::endl;
+        std::remove(graph_tmp_file.c_str());
+        return false;
+    }
+
+    std::vector<std::unordered_map<std::string, VertexID> > vertices_with_newid(label_num);
+    for (VertexID v = 0; v < base.vertex_num; v++) {
+        vertices_with_newid[id_map.getLabel(v)][std::to_string(id_map.getRawId(v))] = compact_id[v];
+    }
+    for (ui i = 0; i < delta.new_vertex_label.size(); i++) {
+        vertices_with_newid[delta.new_vertex_label[i]][std::to_string(delta.new_vertex_raw_id[i])] = compact_id[base.vertex_num + i];
+    }
+    if (!writeIdMap(id_map_tmp_file, vertex_num, label_num, vertex_num_offset.data(), vertices_with_newid)) {
+        std::cout << "cannot write the compacted id map, compaction aborted!" << std::endl;
+        std::remove(graph_tmp_file.c_str());
+        std::remove(id_map_tmp_file.c_str());
+        return false;
+    }
+
+    // The graph goes first: a complete .idmap.tmp without a .tmp graph marks a swap
+    // which stopped half way, and finishSwap() completes it before the next update.
+    if (std::rename(graph_tmp_file.c_str(), graph_file.c_str()) != 0) {
+        std::cout << "cannot replace the graph, compaction aborted!" << std::endl;
+        std::remove(graph_tmp_file.c_str());
+        std::remove(id_map_tmp_file.c_str());
+        return false;
+    }
+    if (std::rename(id_map_tmp_file.c_str(), (graph_file + ".idmap").c_str()) != 0) {
+        std::cout << "cannot replace the id map, the next update finishes the compaction!" << std::endl;
+    }
+
+    std::cout << "\tcompacted |V|: " << vertex_num << " |E|: " << BaseGraph::edgeNum(out_degree) << std::endl;
+    std::cout << "\tonly the data graph and id map are rebuilt, other side files of the graph are stale" << std::endl;
+    return true;
+}
+
+// Complete a compaction which replaced the graph but not yet its id map, returns false if there was none
+static bool finishSwap(const std::string &graph_file) {
+    std::string id_map_tmp_file = graph_file + ".idmap.tmp";
+    if (std::ifstream(graph_file + ".tmp").good() || !std::ifstream(id_map_tmp_file).good()) {
+        return false;
+    }
+    std::rename(id_map_tmp_file.c_str(), (graph_file + ".idmap").c_str());
+    std::remove((graph_file + ".delta.compacting").c_str());
+    return true;
+}
+
+// A failed compaction leaves the graph untouched, so its delta is put back for a later retry
+static void finishCompaction(const std::string &graph_file, const GraphDelta &delta,
+                             const std::string &delta_file, const std::string &compacting_file) {
+    if (compactGraph(graph_file, delta)) {
+        std::remove(compacting_file.c_str());
+    } else {
+        std::rename(compacting_file.c_str(), delta_file.c_str());
+    }
+}
+
+// Called with the update lock held, so a compacting delta left behind belongs to a compaction which died
+static void recoverCompaction(const std::string &graph_file, const std::string &delta_file, const std::string &compacting_file) {
+    if (finishSwap(graph_file)) {
+        std::cout << "\tfinished an interrupted compaction" << std::endl;
+        return;
+    }
+    if (!std::ifstream(compacting_file).good()) {
+        return;
+    }
+    // the delta is only put back if the graph it was made for is still in place
+    GraphDelta delta;
+    BaseGraph base;
+    if (delta.load(compacting_file) && base.load(graph_file, false)
+        && (base.vertex_num != delta.base_vertex_num || BaseGraph::edgeNum(base.out_degree) != delta.base_edge_num)) {
+        std::remove(compacting_file.c_str());
+        std::cout << "\tdropped the delta of a stopped compaction, the graph already holds it" << std::endl;
+        return;
+    }
+    std::remove((graph_file + ".tmp").c_str());
+    std::remove((graph_file + ".idmap.tmp").c_str());
+    std::rename(compacting_file.c_str(), delta_file.c_str());
+    std::cout << "\trestored the delta of a stopped compaction" << std::endl;
+}
+
+static void updateGraph(const std::string &update_path, const std::vector<std::string> &vertices_files,
+                        const std::vector<std::string> &edges_files, const std::string &graph_file,
+                        const std::string &label_file, double compact_threshold) {
+    std::string delta_file = graph_file + ".delta";
+    std::string compacting_file = delta_file + ".compacting";
+    recoverCompaction(graph_file, delta_file, compacting_file);
+
+    std::vector<std::string> labels = readLabels(label_file);
+    IdMap id_map;
+    if (labels.empty() || !id_map.load(graph_file + ".idmap")) {
+        std::cout << "updates need the label file and the id map (-idmap) of the graph!" << std::endl;
+        return;
+    }
+    GraphDelta delta;
+    if (!delta.load(delta_file)) {
+        BaseGraph base;
+        if (!base.load(graph_file, false)) {
+            return;
+        }
+        delta.base_vertex_num = base.vertex_num;
+        delta.base_edge_num = BaseGraph::edgeNum(base.out_degree);
+    }
+
+    std::vector<std::unordered_map<uint64_t, VertexID> > delta_vertices(labels.size());
+    for (ui i = 0; i < delta.new_vertex_label.size(); i++) {
+        delta_vertices[delta.new_vertex_label[i]][delta.new_vertex_raw_id[i]] = delta.base_vertex_num + i;
+    }
+
+    // find a vertex in a label, or in any specific label of it (e.g. place -> place_city)
+    auto resolve = [&](const std::string &label, uint64_t raw_id) -> VertexID {
+        for (ui l = 0; l < labels.size(); l++) {
+            if (labels[l] != label && labels[l].compare(0, label.size() + 1, label + "_") != 0) {
+                continue;
+            }
+            VertexID id;
+            if (id_map.find(l, raw_id, id)) {
+                return id;
+            }
+            auto it = delta_vertices[l].find(raw_id);
+            if (it != delta_vertices[l].end()) {
+                return it->second;
+            }
+        }
+        return UINT_MAX;
+    };
+
+    uint64_t new_vertex_num = 0;
+    uint64_t new_edge_num = 0;
+    uint64_t skipped_num = 0;
+
+    for (auto const& file : vertices_files) {
+        csv::CSVReader reader(update_path + file);
+        std::vector<std::string> col_names = reader.get_col_names();
+
+        int id_col = -1;
+        int type_col = -1;
+        for (long unsigned i = 0; i < col_names.size(); i++) {
+            if (col_names[i].find("id") != std::string::npos) {
+                id_col = i;
+            } else if (col_names[i].find("type") != std::string::npos) {
+                type_col = i;
+            }
+        }
+        std::string overall_label = file.substr(0, file.find("_"));
+        std::transform(overall_label.begin(), overall_label.end(), overall_label.begin(), ::tolower);
+
+        csv::CSVRow row;
+        while (reader.read_row(row)) {
+            std::string label = overall_label;
+            if (type_col != -1) {
+                std::string type = row[type_col].get();
+                std::transform(type.begin(), type.end(), type.begin(), ::tolower);
+                label += "_" + type;
+            }
+            ui label_index = std::find(labels.begin(), labels.end(), label) - labels.begin();
+            uint64_t raw_id = std::strtoull(row[id_col].get().c_str(), nullptr, 10);
+            if (label_index == labels.size() || resolve(label, raw_id) != UINT_MAX) {
+                skipped_num++;
+                continue;
+            }
+            delta_vertices[label_index][raw_id] = delta.base_vertex_num + delta.new_vertex_label.size();
+            delta.new_vertex_label.push_back(label_index);
+            delta.new_vertex_raw_id.push_back(raw_id);
+            new_vertex_num++;
+        }
+    }
+
+    for (auto const& file : edges_files) {
+        csv::CSVReader reader(update_path + file);
+        std::vector<std::string> col_names = reader.get_col_names();
+
+        int src_col = -1;
+        int dest_col = -1;
+        std::string src_label;
+        std::string dest_label;
+        for (long unsigned i = 0; i < col_names.size(); i++) {
+            if (col_names[i].find(".id") != std::string::npos) {
+                std::string label = col_names[i].substr(0, col_names[i].find(".id"));
+                std::transform(label.begin(), label.end(), label.begin(), ::tolower);
+                if (src_col == -1) {
+                    src_col = i;
+                    src_label = label;
+                } else {
+                    dest_col = i;
+                    dest_label = label;
+                }
+            }
+        }
+
+        csv::CSVRow row;
+        while (reader.read_row(row)) {
+            VertexID src = resolve(src_label, std::strtoull(row[src_col].get().c_str(), nullptr, 10));
+            VertexID dest = resolve(dest_label, std::strtoull(row[dest_col].get().c_str(), nullptr, 10));
+            if (src == UINT_MAX || dest == UINT_MAX) {
+                skipped_num++;
+                continue;
+            }
+            delta.edges.push_back(std::make_pair(src, dest));
+            new_edge_num++;
+        }
+    }
+
+    if (!delta.save(delta_file)) {
+        return;
+    }
+
+    std::cout << "\tnew vertices: " << new_vertex_num << " new edges: " << new_edge_num
+              << " skipped rows: " << skipped_num << std::endl;
+    std::cout << "\tdelta vertices: " << delta.new_vertex_label.size() << " delta edges: " << delta.edges.size() << std::endl;
+
+    if (delta.edges.size() > compact_threshold * delta.base_edge_num) {
+        // The delta is moved aside for the compaction, which also blocks further
+        // updates until the graph is replaced, since they would use the old IDs.
+        std::rename(delta_file.c_str(), compacting_file.c_str());
+        std::cout.flush();
+        pid_t pid = fork();
+        if (pid == 0) {
+            finishCompaction(graph_file, delta, delta_file, compacting_file);
+            _exit(0);
+        } else if (pid > 0) {
+            std::cout << "\tdelta exceeds the compaction threshold, compacting in background (pid " << pid << ")" << std::endl;
+        } else {
+            std::cout << "\tcannot start background compaction, compacting..." << std::endl;
+            finishCompaction(graph_file, delta, delta_file, compacting_file);
+        }
+    }
+}
+
+void applyUpdates(const std::string &update_path, const std::vector<std::string> &vertices_files,
+                  const std::vector<std::string> &edges_files, const std::string &graph_file,
+                  const std::string &label_file, double compact_threshold) {
+    // The lock is inherited by the background compaction, so it is held until the
+    // compaction ends or dies, and a compaction which died leaves no stale lock.
+    std::string lock_file = graph_file + ".delta.lock";
+    int lock = open(lock_file.c_str(), O_RDWR | O_CREAT, 0644);
+    if (lock == -1) {
+        std::cout << "cannot open " << lock_file << "!" << std::endl;
+        return;
+    }
+    if (flock(lock, LOCK_EX | LOCK_NB) != 0) {
+        std::cout << "an update or compaction of this graph is still running, retry later!" << std::endl;
+        close(lock);
+        return;
+    }
+    updateGraph(update_path, vertices_files, edges_files, graph_file, label_file, compact_threshold);
+    close(lock);
+}
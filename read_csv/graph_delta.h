@@ -0,0 +1,55 @@
+#ifndef GRAPH_DELTA_H
+#define GRAPH_DELTA_H
+
+#include "type.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Pending insertions on top of an existing data graph (<graph>.delta).
+ *
+ * New vertices get IDs base_vertex_num, base_vertex_num + 1, ... in arrival
+ * order, so they break label contiguity until the delta is compacted into a new
+ * CSR, which places them at the end of their label range and renumbers the rest.
+ *
+ * Layout:
+ *   ui magic, ui base_vertex_num, uint64_t base_edge_num, ui new_vertex_num,
+ *   LabelID new_vertex_label[new_vertex_num], uint64_t new_vertex_raw_id[new_vertex_num],
+ *   uint64_t edge_num, (VertexID src, VertexID dest) edges[edge_num]
+ */
+#define GRAPH_DELTA_MAGIC 0x31544c44     // "DLT1"
+
+struct GraphDelta {
+    ui base_vertex_num;
+    uint64_t base_edge_num;
+    std::vector<LabelID> new_vertex_label;
+    std::vector<uint64_t> new_vertex_raw_id;
+    std::vector<std::pair<VertexID, VertexID> > edges;
+
+    GraphDelta() : base_vertex_num(0), base_edge_num(0) {}
+
+    bool load(const std::string &file_path);
+    // Written to <file_path>.tmp and renamed over the file, false if the old file was kept
+    bool save(const std::string &file_path) const;
+};
+
+/*
+ * Apply insert-only vertex and edge CSV files (same layout as the input of a full
+ * conversion) to the graph, its label file and its id map. Insertions are
+ * appended to <graph>.delta. Once the delta holds more than
+ * compact_threshold * base edges, it is merged into a new CSR by a background
+ * process, which replaces the graph and id map files by rename when done.
+ * Updates are refused while another update or its compaction holds the lock on
+ * <graph>.delta.lock. A failed compaction puts the delta back; after one which
+ * died, the next update completes a swap interrupted between the graph and the
+ * id map, or otherwise puts the delta back.
+ */
+void applyUpdates(const std::string &update_path, const std::vector<std::string> &vertices_files,
+                  const std::vector<std::string> &edges_files, const std::string &graph_file,
+                  const std::string &label_file, double compact_threshold);
+
+// Merge the delta into a new CSR with contiguous label ranges, false if the graph was left unchanged
+bool compactGraph(const std::string &graph_file, const GraphDelta &delta);
+
+#endif
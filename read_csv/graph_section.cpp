@@ -0,0 +1,94 @@
+#include "graph_section.h"
+#include "utility/parallel_for.h"
+#include <vector>
+
+void writeSectionHeader(std::ofstream &descriptor, ui tag, uint64_t size) {
+    descriptor.write((char*)&tag, sizeof(ui));
+    descriptor.write((char*)&size, sizeof(uint64_t));
+}
+
+void writeNeighborLabelOffset(std::ofstream &descriptor, ui tag, ui vertex_num, ui label_num,
+                              const ui* vertex_num_offset, const ui* degree, VertexID** neighbors_array) {
+    // dense entries cost label_num + 1 slots, sparse ones two slots per run
+    ui dense_threshold = label_num + 1;
+
+    std::vector<ui> entry_offset(vertex_num + 1);
+    std::vector<ui> entries;
+    entry_offset[0] = 0;
+
+    for (ui i = 0; i < vertex_num; i++) {
+        if (degree[i] >= dense_threshold) {
+            ui position = 0;
+            for (ui label = 0; label < label_num; label++) {
+                entries.push_back(position);
+                while (position < degree[i] && neighbors_array[i][position] < vertex_num_offset[label + 1]) {
+                    position++;
+                }
+            }
+            entries.push_back(degree[i]);
+        } else {
+            ui label = 0;
+            for (ui position = 0; position < degree[i]; position++) {
+                if (position == 0 || neighbors_array[i][position] >= vertex_num_offset[label + 1]) {
+                    while (neighbors_array[i][position] >= vertex_num_offset[label + 1]) {
+                        label++;
+                    }
+                    entries.push_back(label);
+                    entries.push_back(position);
+                }
+            }
+        }
+        entry_offset[i + 1] = entries.size();
+    }
+
+    uint64_t size = sizeof(ui) * (2 + entry_offset.size() + entries.size());
+    writeSectionHeader(descriptor, tag, size);
+    descriptor.write((char*)&label_num, sizeof(ui));
+    descriptor.write((char*)&dense_threshold, sizeof(ui));
+    descriptor.write((char*)entry_offset.data(), sizeof(ui) * entry_offset.size());
+    descriptor.write((char*)entries.data(), sizeof(ui) * entries.size());
+}
+
+void writeNeighborLabelFrequency(std::ofstream &descriptor, ui tag, ui vertex_num, ui label_num,
+                                 const ui* vertex_num_offset, const ui* degree, VertexID** neighbors_array) {
+    // number of distinct neighbor labels per vertex decides between the two formats
+    std::vector<ui> entry_offset(vertex_num + 1, 0);
+    parallelFor(vertex_num, [&](ui, ui begin, ui end) {
+        for (ui i = begin; i < end; i++) {
+            visitLabelRuns(neighbors_array[i], degree[i], vertex_num_offset, [&](ui, ui) {
+                entry_offset[i + 1] += 2;
+            });
+        }
+    });
+    for (ui i = 0; i < vertex_num; i++) {
+        entry_offset[i + 1] += entry_offset[i];
+    }
+
+    uint64_t dense_size = (uint64_t)vertex_num * label_num;
+    uint64_t sparse_size = entry_offset.size() + (uint64_t)entry_offset[vertex_num];
+    ui format = sparse_size < dense_size ? 1 : 0;
+
+    std::vector<ui> entries(format == 0 ? dense_size : entry_offset[vertex_num], 0);
+    parallelFor(vertex_num, [&](ui, ui begin, ui end) {
+        for (ui i = begin; i < end; i++) {
+            uint64_t position = format == 0 ? (uint64_t)i * label_num : entry_offset[i];
+            visitLabelRuns(neighbors_array[i], degree[i], vertex_num_offset, [&](ui label, ui count) {
+                if (format == 0) {
+                    entries[position + label] = count;
+                } else {
+                    entries[position++] = label;
+                    entries[position++] = count;
+                }
+            });
+        }
+    });
+
+    uint64_t size = sizeof(ui) * (2 + (format == 0 ? 0 : entry_offset.size()) + entries.size());
+    writeSectionHeader(descriptor, tag, size);
+    descriptor.write((char*)&label_num, sizeof(ui));
+    descriptor.write((char*)&format, sizeof(ui));
+    if (format == 1) {
+        descriptor.write((char*)entry_offset.data(), sizeof(ui) * entry_offset.size());
+    }
+    descriptor.write((char*)entries.data(), sizeof(ui) * entries.size());
+}
@@ -0,0 +1,68 @@
+#ifndef GRAPH_SECTION_H
+#define GRAPH_SECTION_H
+
+#include "type.h"
+#include <algorithm>
+#include <fstream>
+
+/*
+ * Optional sections of a data graph file.
+ *
+ * A data graph file starts with the fixed layout written by CSVReader:
+ *   ui vertex_num, ui size_vertex_num_offset, ui vertex_num_offset[size_vertex_num_offset],
+ *   ui in_degree[vertex_num], ui out_degree[vertex_num],
+ *   in-neighbor lists, out-neighbor lists.
+ * Any number of optional sections may follow, each framed as
+ *   ui tag, uint64_t payload size in bytes, payload.
+ * Loaders which only read the fixed layout are unaffected, and loaders which
+ * understand sections can skip unknown tags by their size.
+ */
+enum GraphSection {
+    InNeighborLabelOffset = 1,      // neighbor-label runs of in-neighbor lists
+    OutNeighborLabelOffset = 2,     // neighbor-label runs of out-neighbor lists
+    InNeighborLabelFrequency = 3,   // per-vertex in-neighbor counts by label
+    OutNeighborLabelFrequency = 4   // per-vertex out-neighbor counts by label
+};
+
+void writeSectionHeader(std::ofstream &descriptor, ui tag, uint64_t size);
+
+// Call visit(label, count) for every label run of a sorted neighbor list
+template <typename Visit>
+void visitLabelRuns(const VertexID* neighbors, ui degree, const ui* vertex_num_offset, Visit visit) {
+    ui label = 0;
+    ui position = 0;
+    while (position < degree) {
+        while (neighbors[position] >= vertex_num_offset[label + 1]) {
+            label++;
+        }
+        ui run_end = std::lower_bound(neighbors + position, neighbors + degree, vertex_num_offset[label + 1]) - neighbors;
+        visit(label, run_end - position);
+        position = run_end;
+    }
+}
+
+/*
+ * Neighbor-label offset section payload:
+ *   ui label_num, ui dense_threshold, ui entry_offset[vertex_num + 1], ui entries[entry_offset[vertex_num]]
+ * Neighbor lists are sorted and labels own contiguous ID ranges, so each list is a
+ * sequence of runs, one per neighbor label. For vertex v the entries in
+ * [entry_offset[v], entry_offset[v + 1]) describe these runs:
+ *   degree >= dense_threshold: label_num + 1 positions, the run of label l is [entries[l], entries[l + 1])
+ *   degree <  dense_threshold: (label, start position) pairs in label order, a run ends
+ *                              where the next one starts or at the end of the list
+ */
+void writeNeighborLabelOffset(std::ofstream &descriptor, ui tag, ui vertex_num, ui label_num,
+                              const ui* vertex_num_offset, const ui* degree, VertexID** neighbors_array);
+
+/*
+ * Neighbor-label frequency (NLF) section payload:
+ *   ui label_num, ui format, then
+ *   format 0 (dense):  ui counts[vertex_num * label_num], counts[v * label_num + l] neighbors of label l
+ *   format 1 (sparse): ui entry_offset[vertex_num + 1], ui entries[entry_offset[vertex_num]],
+ *                      (label, count) pairs in label order for the labels v has neighbors of
+ * The smaller of the two formats is written. Counts are computed in parallel.
+ */
+void writeNeighborLabelFrequency(std::ofstream &descriptor, ui tag, ui vertex_num, ui label_num,
+                                 const ui* vertex_num_offset, const ui* degree, VertexID** neighbors_array);
+
+#endif
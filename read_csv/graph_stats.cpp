@@ -0,0 +1,97 @@
+#include "graph_stats.h"
+#include "graph_section.h"
+#include "utility/parallel_for.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+static inline ui degreeBucket(ui degree) {
+    return 31 - __builtin_clz(degree);
+}
+
+/*
+ * Accumulate the per-vertex label runs of one direction into stats. For out
+ * lists the vertex is the source of the pair, for in lists the destination.
+ */
+static void accumulateDirection(std::vector<LabelPairStats> &stats, bool out_direction, ui vertex_num, ui label_num,
+                                const ui* vertex_num_offset, const ui* degree, VertexID** neighbors_array) {
+    ui thread_num = parallelForThreads(vertex_num);
+    std::vector<std::vector<LabelPairStats> > partials(thread_num, std::vector<LabelPairStats>(stats.size()));
+    for (auto &partial : partials) {
+        std::memset(partial.data(), 0, sizeof(LabelPairStats) * partial.size());
+    }
+
+    parallelFor(vertex_num, [&](ui thread, ui begin, ui end) {
+        std::vector<LabelPairStats> &partial = partials[thread];
+        ui label = std::upper_bound(vertex_num_offset, vertex_num_offset + label_num + 1, begin) - vertex_num_offset - 1;
+        for (ui i = begin; i < end; i++) {
+            while (i >= vertex_num_offset[label + 1]) {
+                label++;
+            }
+            visitLabelRuns(neighbors_array[i], degree[i], vertex_num_offset, [&](ui neighbor_label, ui count) {
+                if (out_direction) {
+                    LabelPairStats &pair = partial[label * label_num + neighbor_label];
+                    pair.edge_num += count;
+                    pair.distinct_src++;
+                    pair.max_out_degree = std::max(pair.max_out_degree, count);
+                    pair.out_degree_histogram[degreeBucket(count)]++;
+                } else {
+                    LabelPairStats &pair = partial[neighbor_label * label_num + label];
+                    pair.distinct_dest++;
+                    pair.max_in_degree = std::max(pair.max_in_degree, count);
+                    pair.in_degree_histogram[degreeBucket(count)]++;
+                }
+            });
+        }
+    });
+
+    for (auto const& partial : partials) {
+        for (size_t i = 0; i < stats.size(); i++) {
+            stats[i].edge_num += partial[i].edge_num;
+            stats[i].distinct_src += partial[i].distinct_src;
+            stats[i].distinct_dest += partial[i].distinct_dest;
+            stats[i].max_out_degree = std::max(stats[i].max_out_degree, partial[i].max_out_degree);
+            stats[i].max_in_degree = std::max(stats[i].max_in_degree, partial[i].max_in_degree);
+            for (ui bucket = 0; bucket < DEGREE_BUCKET_NUM; bucket++) {
+                stats[i].out_degree_histogram[bucket] += partial[i].out_degree_histogram[bucket];
+                stats[i].in_degree_histogram[bucket] += partial[i].in_degree_histogram[bucket];
+            }
+        }
+    }
+}
+
+void writeGraphStats(const std::string &file_path, ui vertex_num, ui label_num, const ui* vertex_num_offset,
+                     const ui* in_degree, const ui* out_degree,
+                     VertexID** in_neighbors_array, VertexID** out_neighbors_array) {
+    std::vector<LabelPairStats> stats((size_t)label_num * label_num);
+    std::memset(stats.data(), 0, sizeof(LabelPairStats) * stats.size());
+
+    accumulateDirection(stats, true, vertex_num, label_num, vertex_num_offset, out_degree, out_neighbors_array);
+    accumulateDirection(stats, false, vertex_num, label_num, vertex_num_offset, in_degree, in_neighbors_array);
+
+    for (auto &pair : stats) {
+        pair.avg_out_degree = pair.distinct_src == 0 ? 0 : (double)pair.edge_num / pair.distinct_src;
+        pair.avg_in_degree = pair.distinct_dest == 0 ? 0 : (double)pair.edge_num / pair.distinct_dest;
+    }
+
+    std::vector<ui> vertex_count(label_num);
+    for (ui label = 0; label < label_num; label++) {
+        vertex_count[label] = vertex_num_offset[label + 1] - vertex_num_offset[label];
+    }
+
+    std::ofstream descriptor(file_path, std::ios::binary);
+
+    ui magic = GRAPH_STATS_MAGIC;
+    ui bucket_num = DEGREE_BUCKET_NUM;
+    descriptor.write((char*)&magic, sizeof(ui));
+    descriptor.write((char*)&label_num, sizeof(ui));
+    descriptor.write((char*)&bucket_num, sizeof(ui));
+    descriptor.write((char*)vertex_count.data(), sizeof(ui) * label_num);
+    if ((3 + label_num) % 2 == 1) {
+        ui padding = 0;
+        descriptor.write((char*)&padding, sizeof(ui));
+    }
+    descriptor.write((char*)stats.data(), sizeof(LabelPairStats) * stats.size());
+
+    descriptor.close();
+}
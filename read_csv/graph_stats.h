@@ -0,0 +1,36 @@
+#ifndef GRAPH_STATS_H
+#define GRAPH_STATS_H
+
+#include "type.h"
+#include <string>
+
+/*
+ * Statistics file (<graph>.stats) for query optimization, computed from the
+ * merged adjacency.
+ *
+ * Layout:
+ *   ui magic, ui label_num, ui bucket_num, ui vertex_count[label_num], padding to 8 bytes,
+ *   LabelPairStats pairs[label_num * label_num], pairs[a * label_num + b] for edges a -> b
+ * Histogram bucket k counts vertices whose degree restricted to the pair is in
+ * [2^k, 2^(k+1)); vertices without such edges are not counted.
+ */
+#define GRAPH_STATS_MAGIC 0x31545347     // "GST1"
+#define DEGREE_BUCKET_NUM 32
+
+struct LabelPairStats {
+    uint64_t edge_num;
+    ui distinct_src;                        // label a vertices with at least one such edge
+    ui distinct_dest;                       // label b vertices with at least one such edge
+    ui max_out_degree;                      // most b out-neighbors of one a vertex
+    ui max_in_degree;                       // most a in-neighbors of one b vertex
+    double avg_out_degree;                  // over distinct_src
+    double avg_in_degree;                   // over distinct_dest
+    uint64_t out_degree_histogram[DEGREE_BUCKET_NUM];
+    uint64_t in_degree_histogram[DEGREE_BUCKET_NUM];
+};
+
+void writeGraphStats(const std::string &file_path, ui vertex_num, ui label_num, const ui* vertex_num_offset,
+                     const ui* in_degree, const ui* out_degree,
+                     VertexID** in_neighbors_array, VertexID** out_neighbors_array);
+
+#endif
@@ -0,0 +1,106 @@
+#include "id_assignment.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+#include <unordered_set>
+
+IdAssignment parseIdAssignment(const std::string &assignment) {
+    if (assignment.empty() || assignment == "lexical") {
+        return IdAssignment::Lexical;
+    } else if (assignment == "numeric") {
+        return IdAssignment::Numeric;
+    } else if (assignment == "firstseen") {
+        return IdAssignment::FirstSeen;
+    }
+    std::cout << "wrong id assignment!" << std::endl;
+    return IdAssignment::Lexical;
+}
+
+void radixSortByKey(const std::vector<uint64_t> &keys, std::vector<ui> &index) {
+    std::vector<ui> buffer(index.size());
+    for (ui shift = 0; shift < 64; shift += 8) {
+        size_t count[257] = {0};
+        for (auto i : index) {
+            count[((keys[i] >> shift) & 0xFF) + 1]++;
+        }
+        // every key has the same byte here
+        if (std::find(count + 1, count + 257, index.size()) != count + 257) {
+            continue;
+        }
+        for (ui byte = 0; byte < 256; byte++) {
+            count[byte + 1] += count[byte];
+        }
+        for (auto i : index) {
+            buffer[count[(keys[i] >> shift) & 0xFF]++] = i;
+        }
+        index.swap(buffer);
+    }
+}
+
+static bool parseNumericIds(const std::vector<std::string> &raw_ids, std::vector<uint64_t> &keys) {
+    keys.resize(raw_ids.size());
+    for (size_t i = 0; i < raw_ids.size(); i++) {
+        const std::string &raw = raw_ids[i];
+        if (raw.empty() || raw.size() > 20 || !std::all_of(raw.begin(), raw.end(), ::isdigit)) {
+            return false;
+        }
+        errno = 0;
+        keys[i] = std::strtoull(raw.c_str(), nullptr, 10);
+        if (errno != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> orderVertexIds(IdAssignment assignment, const std::vector<std::string> &raw_ids) {
+    std::vector<std::string> ordered_ids;
+    ordered_ids.reserve(raw_ids.size());
+
+    std::vector<uint64_t> keys;
+    if (assignment == IdAssignment::Numeric && !parseNumericIds(raw_ids, keys)) {
+        std::cout << "non-numeric vertex id, falling back to lexical order!" << std::endl;
+        assignment = IdAssignment::Lexical;
+    }
+
+    if (assignment == IdAssignment::Numeric) {
+        std::vector<ui> index(raw_ids.size());
+        for (ui i = 0; i < index.size(); i++) {
+            index[i] = i;
+        }
+        radixSortByKey(keys, index);
+        // ids are deduplicated as strings, so "007" and "7" stay two vertices (in lexical order)
+        std::vector<std::string> tie;
+        for (size_t begin = 0, end = 0; begin < index.size(); begin = end) {
+            while (end < index.size() && keys[index[end]] == keys[index[begin]]) {
+                end++;
+            }
+            if (end - begin == 1) {
+                ordered_ids.push_back(raw_ids[index[begin]]);
+                continue;
+            }
+            tie.clear();
+            for (size_t i = begin; i < end; i++) {
+                tie.push_back(raw_ids[index[i]]);
+            }
+            std::sort(tie.begin(), tie.end());
+            tie.erase(std::unique(tie.begin(), tie.end()), tie.end());
+            ordered_ids.insert(ordered_ids.end(), tie.begin(), tie.end());
+        }
+    } else if (assignment == IdAssignment::FirstSeen) {
+        std::unordered_set<std::string> seen;
+        seen.reserve(raw_ids.size());
+        for (auto const& raw : raw_ids) {
+            if (seen.insert(raw).second) {
+                ordered_ids.push_back(raw);
+            }
+        }
+    } else {
+        ordered_ids = raw_ids;
+        std::sort(ordered_ids.begin(), ordered_ids.end());
+        ordered_ids.erase(std::unique(ordered_ids.begin(), ordered_ids.end()), ordered_ids.end());
+    }
+    return ordered_ids;
+}
@@ -0,0 +1,26 @@
+#ifndef ID_ASSIGNMENT_H
+#define ID_ASSIGNMENT_H
+
+#include "type.h"
+#include <string>
+#include <vector>
+
+enum IdAssignment {
+    Lexical = 0,        // raw ids compared as strings, "10" before "9"
+    Numeric = 1,        // raw ids compared as unsigned integers
+    FirstSeen = 2       // order of first appearance in the vertex files
+};
+
+IdAssignment parseIdAssignment(const std::string &assignment);
+
+// LSD radix sort of index by keys[index[i]], stable, passes over constant bytes are skipped
+void radixSortByKey(const std::vector<uint64_t> &keys, std::vector<ui> &index);
+
+/*
+ * Deduplicate the raw ids read for one label and put them in the order new
+ * vertex IDs are assigned in. Numeric falls back to lexical order if some raw id
+ * is not an unsigned integer.
+ */
+std::vector<std::string> orderVertexIds(IdAssignment assignment, const std::vector<std::string> &raw_ids);
+
+#endif
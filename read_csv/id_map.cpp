@@ -0,0 +1,166 @@
+#include "id_map.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static size_t headerSize(ui label_num) {
+    size_t size = sizeof(ui) * (3 + label_num + 1);
+    return (size + 7) / 8 * 8;
+}
+
+// Accepts only ids printed back unchanged, so "007" and "7" cannot both map to 7
+static bool parseRawId(const std::string &raw, uint64_t &value) {
+    if (raw.empty() || !std::all_of(raw.begin(), raw.end(), ::isdigit)) {
+        return false;
+    }
+    errno = 0;
+    value = std::strtoull(raw.c_str(), nullptr, 10);
+    return errno == 0 && std::to_string(value) == raw;
+}
+
+// Place sorted[position...] into the Eytzinger layout rooted at node (1-based)
+static void buildEytzinger(const std::vector<std::pair<uint64_t, VertexID> > &sorted, size_t &position, size_t node,
+                           uint64_t* keys, VertexID* ids) {
+    if (node > sorted.size()) {
+        return;
+    }
+    buildEytzinger(sorted, position, 2 * node, keys, ids);
+    keys[node - 1] = sorted[position].first;
+    ids[node - 1] = sorted[position].second;
+    position++;
+    buildEytzinger(sorted, position, 2 * node + 1, keys, ids);
+}
+
+bool writeIdMap(const std::string &file_path, ui vertex_num, ui label_num, const ui* vertex_num_offset,
+                const std::vector<std::unordered_map<std::string, VertexID> > &vertices_with_newid) {
+    std::vector<uint64_t> raw_keys(vertex_num);
+    std::vector<uint64_t> raw_ids(vertex_num);
+    std::vector<VertexID> key_ids(vertex_num);
+
+    for (ui label = 0; label < label_num; label++) {
+        std::vector<std::pair<uint64_t, VertexID> > sorted;
+        sorted.reserve(vertices_with_newid[label].size());
+        for (auto const& vertex : vertices_with_newid[label]) {
+            uint64_t raw_id;
+            if (!parseRawId(vertex.first, raw_id)) {
+                std::cout << "vertex id " << vertex.first << " is not a plain unsigned integer, id map is not written!" << std::endl;
+                return false;
+            }
+            sorted.push_back(std::make_pair(raw_id, vertex.second));
+            raw_ids[vertex.second] = raw_id;
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        size_t position = 0;
+        buildEytzinger(sorted, position, 1, raw_keys.data() + vertex_num_offset[label], key_ids.data() + vertex_num_offset[label]);
+    }
+
+    std::ofstream descriptor(file_path, std::ios::binary);
+
+    ui magic = ID_MAP_MAGIC;
+    descriptor.write((char*)&magic, sizeof(ui));
+    descriptor.write((char*)&vertex_num, sizeof(ui));
+    descriptor.write((char*)&label_num, sizeof(ui));
+    descriptor.write((char*)vertex_num_offset, sizeof(ui) * (label_num + 1));
+    std::vector<char> padding(headerSize(label_num) - sizeof(ui) * (3 + label_num + 1), 0);
+    descriptor.write(padding.data(), padding.size());
+    descriptor.write((char*)raw_keys.data(), sizeof(uint64_t) * vertex_num);
+    descriptor.write((char*)raw_ids.data(), sizeof(uint64_t) * vertex_num);
+    descriptor.write((char*)key_ids.data(), sizeof(VertexID) * vertex_num);
+
+    descriptor.close();
+    if (descriptor.fail()) {
+        std::cout << "cannot write id map " << file_path << "!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+IdMap::~IdMap() {
+    unload();
+}
+
+void IdMap::unload() {
+    if (mapped != nullptr) {
+        munmap(mapped, mapped_size);
+    }
+    mapped = nullptr;
+    mapped_size = 0;
+    vertex_num = 0;
+    label_num = 0;
+    vertex_num_offset = nullptr;
+    raw_keys = nullptr;
+    raw_ids = nullptr;
+    key_ids = nullptr;
+}
+
+bool IdMap::load(const std::string &file_path) {
+    unload();
+    int fd = open(file_path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cout << "wrong path!" << std::endl;
+        return false;
+    }
+    struct stat file_stat;
+    fstat(fd, &file_stat);
+    size_t file_size = file_stat.st_size;
+    void* file = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (file == MAP_FAILED) {
+        std::cout << "cannot map id map file!" << std::endl;
+        return false;
+    }
+    mapped = file;
+    mapped_size = file_size;
+
+    const ui* header = (const ui*)mapped;
+    if (mapped_size < sizeof(ui) * 3 || header[0] != ID_MAP_MAGIC) {
+        std::cout << "not an id map file!" << std::endl;
+        unload();
+        return false;
+    }
+    vertex_num = header[1];
+    label_num = header[2];
+    vertex_num_offset = header + 3;
+
+    const char* base = (const char*)mapped + headerSize(label_num);
+    if (mapped_size < headerSize(label_num) + (size_t)vertex_num * (2 * sizeof(uint64_t) + sizeof(VertexID))) {
+        std::cout << "truncated id map file!" << std::endl;
+        unload();
+        return false;
+    }
+    raw_keys = (const uint64_t*)base;
+    raw_ids = raw_keys + vertex_num;
+    key_ids = (const VertexID*)(raw_ids + vertex_num);
+    return true;
+}
+
+bool IdMap::find(LabelID label, uint64_t raw_id, VertexID &id) const {
+    const uint64_t* keys = raw_keys + vertex_num_offset[label];
+    size_t n = vertex_num_offset[label + 1] - vertex_num_offset[label];
+
+    // descend to the leaf, then undo the right turns taken after the last left turn
+    size_t node = 1;
+    while (node <= n) {
+        __builtin_prefetch(keys + 16 * node - 1);
+        node = 2 * node + (keys[node - 1] < raw_id);
+    }
+    node >>= __builtin_ffsll(~node);
+
+    if (node == 0 || keys[node - 1] != raw_id) {
+        return false;
+    }
+    id = key_ids[vertex_num_offset[label] + node - 1];
+    return true;
+}
+
+LabelID IdMap::getLabel(VertexID id) const {
+    return std::upper_bound(vertex_num_offset, vertex_num_offset + label_num + 1, id) - vertex_num_offset - 1;
+}
@@ -0,0 +1,61 @@
+#ifndef ID_MAP_H
+#define ID_MAP_H
+
+#include "type.h"
+#include <unordered_map>
+#include <string>
+#include <vector>
+
+/*
+ * Raw id <-> vertex ID map file (<graph>.idmap), laid out to be used through mmap.
+ *
+ * Layout (every uint64_t array starts 8-byte aligned):
+ *   ui magic, ui vertex_num, ui label_num, ui vertex_num_offset[label_num + 1], padding,
+ *   uint64_t raw_keys[vertex_num], uint64_t raw_ids[vertex_num], VertexID key_ids[vertex_num]
+ * raw_keys[vertex_num_offset[l], vertex_num_offset[l + 1]) holds the raw ids of label l
+ * in Eytzinger (BFS) order, key_ids is the vertex ID of each key, and raw_ids is
+ * indexed by vertex ID for the inverse direction.
+ */
+#define ID_MAP_MAGIC 0x314d4449     // "IDM1"
+
+// Returns false if some raw id is not an unsigned integer without leading zeros (nothing is written) or the file cannot be written
+bool writeIdMap(const std::string &file_path, ui vertex_num, ui label_num, const ui* vertex_num_offset,
+                const std::vector<std::unordered_map<std::string, VertexID> > &vertices_with_newid);
+
+class IdMap {
+private:
+    void* mapped;
+    size_t mapped_size;
+    ui vertex_num;
+    ui label_num;
+    const ui* vertex_num_offset;
+    const uint64_t* raw_keys;
+    const uint64_t* raw_ids;
+    const VertexID* key_ids;
+
+    void unload();
+
+public:
+    IdMap() : mapped(nullptr), mapped_size(0), vertex_num(0), label_num(0),
+              vertex_num_offset(nullptr), raw_keys(nullptr), raw_ids(nullptr), key_ids(nullptr) {}
+    ~IdMap();
+
+    // owns the mapping, so copies would unmap it twice
+    IdMap(const IdMap &) = delete;
+    IdMap& operator=(const IdMap &) = delete;
+
+    // Replaces any mapping loaded before; on failure the map is left empty
+    bool load(const std::string &file_path);
+
+    ui getVertexNum() const { return vertex_num; }
+    ui getLabelNum() const { return label_num; }
+
+    // Returns false if the label has no vertex with this raw id
+    bool find(LabelID label, uint64_t raw_id, VertexID &id) const;
+
+    uint64_t getRawId(VertexID id) const { return raw_ids[id]; }
+
+    LabelID getLabel(VertexID id) const;
+};
+
+#endif
@@ -1,10 +1,20 @@
 #include "csv.hpp"
 #include "csv_command.h"
+#include "graph_codec.h"
+#include "graph_delta.h"
+#include "graph_section.h"
+#include "graph_stats.h"
+#include "id_assignment.h"
+#include "id_map.h"
+#include "partition.h"
+#include "relation_segment.h"
+#include "reorder.h"
 #include "type.h"
 #include <dirent.h>
 #include <vector>
 #include <algorithm>
 #include <map>
+#include <unordered_map>
 #include <set>
 #include <fstream>
 #include <chrono>
@@ -40,11 +50,36 @@ int main(int argc, char **argv)
     std::string input_csv_file_path = command.getCSVFilePath();
     std::string output_data_graph_file = command.getGraphFilePath();
     std::string output_label_file = command.getLabelFilePath();
+    bool store_neighbor_label_offset = command.getNeighborLabelOffset();
+    bool store_neighbor_label_frequency = command.getNeighborLabelFrequency();
+    std::string reorder_policy_name = command.getReorderPolicy();
+    bool store_compressed_adjacency = command.getCompressedAdjacency();
+    bool store_relation_segments = command.getRelationSegments();
+    bool store_id_mapping = command.getIdMapping();
+    bool store_graph_statistics = command.getGraphStatistics();
+    ui partition_num = command.getPartitionNum();
+    std::string partition_policy_name = command.getPartitionPolicy();
+    PartitionPolicy partition_policy = parsePartitionPolicy(partition_policy_name);
+    bool update_mode = command.getUpdateMode();
+    double compact_threshold = command.getCompactThreshold();
+    ReorderPolicy reorder_policy = parseReorderPolicy(reorder_policy_name);
+    std::string id_assignment_name = command.getIdAssignment();
+    IdAssignment id_assignment = parseIdAssignment(id_assignment_name);
 
     std::cout << "Command Line:" << std::endl;
     std::cout << "\tCSV Files: " << input_csv_file_path << std::endl;
     std::cout << "\tData Graph: " << output_data_graph_file << std::endl;
     std::cout << "\tLabel: " << output_label_file << std::endl;
+    std::cout << "\tNeighbor Label Offset: " << (store_neighbor_label_offset ? "yes" : "no") << std::endl;
+    std::cout << "\tNeighbor Label Frequency: " << (store_neighbor_label_frequency ? "yes" : "no") << std::endl;
+    std::cout << "\tID Assignment: " << (id_assignment_name.empty() ? "lexical" : id_assignment_name) << std::endl;
+    std::cout << "\tReorder Policy: " << (reorder_policy_name.empty() ? "original" : reorder_policy_name) << std::endl;
+    std::cout << "\tCompressed Adjacency: " << (store_compressed_adjacency ? "yes" : "no") << std::endl;
+    std::cout << "\tRelation Segments: " << (store_relation_segments ? "yes" : "no") << std::endl;
+    std::cout << "\tID Map: " << (store_id_mapping ? "yes" : "no") << std::endl;
+    std::cout << "\tStatistics: " << (store_graph_statistics ? "yes" : "no") << std::endl;
+    std::cout << "\tPartitions: " << partition_num << " (" << (partition_policy_name.empty() ? "hash" : partition_policy_name) << ")" << std::endl;
+    std::cout << "\tUpdate Mode: " << (update_mode ? "yes" : "no") << std::endl;
     std::cout << "--------------------------------------------------------------------" << std::endl;
 
     // get and classify .csv files
@@ -61,12 +96,28 @@ int main(int argc, char **argv)
         }
     }
 
+    if (update_mode) {
+        std::cout << "Applying updates..." << std::endl;
+
+auto start = std::chrono::high_resolution_clock::now();
+
+        applyUpdates(input_csv_file_path, vertices_files, edges_files, output_data_graph_file, output_label_file, compact_threshold);
+
+auto end = std::chrono::high_resolution_clock::now();
+double update_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        std::cout << "--------------------------------------------------------------------" << std::endl;
+        printf("Apply updates time (seconds): %.4lf\n", NANOSECTOSEC(update_time_in_ns));
+        std::cout << "End." << std::endl;
+        return 0;
+    }
+
     std::cout << "Reading vertices..." << std::endl;
 
 auto start = std::chrono::high_resolution_clock::now();
 
-    std::vector<std::map<std::string, VertexID> > vertices_with_newid;
-    std::vector<std::set<std::string> > vertices_with_oldid;
+    std::vector<std::unordered_map<std::string, VertexID> > vertices_with_newid;
+    std::vector<std::vector<std::string> > vertices_with_oldid;
     std::vector<std::string> labels;
     std::vector<std::string> specific_labels;
     std::vector<int> specific_labels_index;
@@ -87,7 +138,8 @@ auto start = std::chrono::high_resolution_clock::now();
             }
         }
         
-        std::vector<std::set<std::string> > vertices_in_this_file;
+        // raw ids in file order, deduplicated and ordered by orderVertexIds
+        std::vector<std::vector<std::string> > vertices_in_this_file;
         std::vector<std::string> labels_in_this_file;
         std::string overall_label;
 
@@ -96,7 +148,7 @@ auto start = std::chrono::high_resolution_clock::now();
             std::transform(label.begin(), label.end(), label.begin(), ::tolower);
             labels_in_this_file.push_back(label);
 
-            std::set<std::string> cur_vertex_set;
+            std::vector<std::string> cur_vertex_set;
             vertices_in_this_file.push_back(cur_vertex_set);
         } else {
             overall_label = file.substr(0, file.find("_"));
@@ -111,7 +163,7 @@ auto start = std::chrono::high_resolution_clock::now();
             std::string id = row[id_col].get();
             
             if (type_col == -1) {
-                vertices_in_this_file[0].insert(id);
+                vertices_in_this_file[0].push_back(id);
             } else {
                 std::string label = row[type_col].get();
                 std::transform(label.begin(), label.end(), label.begin(), ::tolower);
@@ -119,18 +171,19 @@ auto start = std::chrono::high_resolution_clock::now();
 
                 if (std::find(labels_in_this_file.begin(), labels_in_this_file.end(), label) != labels_in_this_file.end()) {
                     int label_index = std::find(labels_in_this_file.begin(), labels_in_this_file.end(), label) - labels_in_this_file.begin();
-                    vertices_in_this_file[label_index].insert(id);
+                    vertices_in_this_file[label_index].push_back(id);
                 } else {
                     labels_in_this_file.push_back(label);
 
-                    std::set<std::string> cur_vertex_set;
-                    cur_vertex_set.insert(id);
+                    std::vector<std::string> cur_vertex_set;
+                    cur_vertex_set.push_back(id);
                     vertices_in_this_file.push_back(cur_vertex_set);
                 }
             }
         }
 
-        for (auto const& vertex_set : vertices_in_this_file) {
+        for (auto &vertex_set : vertices_in_this_file) {
+            vertex_set = orderVertexIds(id_assignment, vertex_set);
             vertices_with_oldid.push_back(vertex_set);
         }
 
@@ -147,7 +200,8 @@ auto start = std::chrono::high_resolution_clock::now();
     ui vertex_num = 0;
     ui label_num = labels.size();
     for (auto const& vertex_set : vertices_with_oldid) {
-        std::map<std::string, VertexID> vertex_set_with_newid;
+        std::unordered_map<std::string, VertexID> vertex_set_with_newid;
+        vertex_set_with_newid.reserve(vertex_set.size());
         for (auto const& vertex : vertex_set) {
             vertex_set_with_newid.insert(std::make_pair(vertex, vertex_num));
             vertex_num++;
@@ -176,6 +230,8 @@ start = std::chrono::high_resolution_clock::now();
     std::vector<std::set<VertexID> > out_neighbors;
     in_neighbors.resize(vertex_num);
     out_neighbors.resize(vertex_num);
+    // edges of every relation, kept apart from the merged adjacency when requested
+    std::vector<RelationEdges> relations;
     // count statistics
     std::vector<std::vector<VertexID> > edge_num;
     VertexID sum_edge = 0;
@@ -233,6 +289,22 @@ start = std::chrono::high_resolution_clock::now();
             dest_label_index = std::find(labels.begin(), labels.end(), dest_label) - labels.begin();
         }
 
+        int relation_index = -1;
+        if (store_relation_segments) {
+            std::string relation_name = relationName(file);
+            for (long unsigned i = 0; i < relations.size(); i++) {
+                if (relations[i].name == relation_name) {
+                    relation_index = i;
+                }
+            }
+            if (relation_index == -1) {
+                relation_index = relations.size();
+                RelationEdges relation;
+                relation.name = relation_name;
+                relations.push_back(relation);
+            }
+        }
+
         CSVRow row;
         while (reader.read_row(row)) {
             std::string src_id = row[src_col].get();
@@ -274,6 +346,10 @@ start = std::chrono::high_resolution_clock::now();
                 }
             }
 
+            if (relation_index != -1) {
+                relations[relation_index].edges.push_back(std::make_pair(src_newid, dest_newid));
+            }
+
             if (out_neighbors[src_newid].insert(dest_newid).second) {
                 in_neighbors[dest_newid].insert(src_newid);
                 edge_num[cur_src_label_index][cur_dest_label_index]++;
@@ -328,6 +404,27 @@ start = std::chrono::high_resolution_clock::now();
 end = std::chrono::high_resolution_clock::now();
 double load_edges_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 
+    std::cout << "--------------------------------------------------------------------" << std::endl;
+    std::cout << "Reordering vertices..." << std::endl;
+
+start = std::chrono::high_resolution_clock::now();
+
+    // new_id[i] is the final ID of the vertex which was assigned ID i while reading vertices
+    std::vector<VertexID> new_id = computeReorder(reorder_policy, vertex_num, label_num, vertex_num_offset,
+                                                  in_neighbors, out_neighbors);
+    if (reorder_policy != ReorderPolicy::Original) {
+        applyReorder(new_id, in_neighbors, out_neighbors);
+        remapRelationEdges(new_id, relations);
+        for (auto &vertex_set_with_newid : vertices_with_newid) {
+            for (auto &vertex : vertex_set_with_newid) {
+                vertex.second = new_id[vertex.second];
+            }
+        }
+    }
+
+end = std::chrono::high_resolution_clock::now();
+double reorder_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
     std::cout << "--------------------------------------------------------------------" << std::endl;
     std::cout << "Storing graph and labels..." << std::endl;
 
@@ -371,8 +468,36 @@ start = std::chrono::high_resolution_clock::now();
         graph_descriptor.write((char*)out_neighbors_array[i], sizeof(VertexID) * out_degree[i]);
     }
 
+    if (store_neighbor_label_offset) {
+        writeNeighborLabelOffset(graph_descriptor, GraphSection::InNeighborLabelOffset, vertex_num, label_num,
+                                 vertex_num_offset, in_degree, in_neighbors_array);
+        writeNeighborLabelOffset(graph_descriptor, GraphSection::OutNeighborLabelOffset, vertex_num, label_num,
+                                 vertex_num_offset, out_degree, out_neighbors_array);
+    }
+
+    if (store_neighbor_label_frequency) {
+        writeNeighborLabelFrequency(graph_descriptor, GraphSection::InNeighborLabelFrequency, vertex_num, label_num,
+                                    vertex_num_offset, in_degree, in_neighbors_array);
+        writeNeighborLabelFrequency(graph_descriptor, GraphSection::OutNeighborLabelFrequency, vertex_num, label_num,
+                                    vertex_num_offset, out_degree, out_neighbors_array);
+    }
+
     graph_descriptor.close();
 
+    if (store_compressed_adjacency) {
+        writeCompressedGraph(output_data_graph_file + ".svb", vertex_num, size_vertex_num_offset, vertex_num_offset,
+                             in_degree, out_degree, in_neighbors_array, out_neighbors_array);
+    }
+
+    if (store_graph_statistics) {
+        writeGraphStats(output_data_graph_file + ".stats", vertex_num, label_num, vertex_num_offset,
+                        in_degree, out_degree, in_neighbors_array, out_neighbors_array);
+    }
+
+    if (store_relation_segments) {
+        writeRelationSegments(output_data_graph_file + ".rel", relations);
+    }
+
     VertexID* label_offset = new VertexID[size_vertex_num_offset];
     label_offset[0] = 0;
     for (VertexID i = 0; i < label_num; i++) {
@@ -391,9 +516,38 @@ start = std::chrono::high_resolution_clock::now();
 
     label_descriptor.close();
 
+    if (reorder_policy != ReorderPolicy::Original) {
+        std::ofstream permutation_descriptor(output_data_graph_file + ".perm", std::ios::binary);
+
+        permutation_descriptor.write((char*)&vertex_num, sizeof(ui));
+        permutation_descriptor.write((char*)new_id.data(), sizeof(VertexID) * vertex_num);
+
+        permutation_descriptor.close();
+    }
+
+    if (store_id_mapping) {
+        writeIdMap(output_data_graph_file + ".idmap", vertex_num, label_num, vertex_num_offset, vertices_with_newid);
+    }
+
 end = std::chrono::high_resolution_clock::now();
 double store_graph_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 
+    double partition_time_in_ns = 0;
+    if (partition_num > 1) {
+        std::cout << "--------------------------------------------------------------------" << std::endl;
+        std::cout << "Partitioning graph..." << std::endl;
+
+start = std::chrono::high_resolution_clock::now();
+
+        std::vector<ui> owner = computePartition(partition_policy, partition_num, vertex_num, label_num, vertex_num_offset,
+                                                 in_degree, out_degree, in_neighbors_array, out_neighbors_array);
+        writePartitions(output_data_graph_file, owner, partition_num, vertex_num, label_num, vertex_num_offset,
+                        in_degree, out_degree, in_neighbors_array, out_neighbors_array);
+
+end = std::chrono::high_resolution_clock::now();
+partition_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+
     std::cout << "--------------------------------------------------------------------" << std::endl;
     delete[] vertex_num_offset;
     delete[] in_degree;
@@ -408,7 +562,9 @@ double store_graph_time_in_ns = std::chrono::duration_cast<std::chrono::nanoseco
     // print time info
     printf("Load vertices time (seconds): %.4lf\n", NANOSECTOSEC(load_vertices_time_in_ns));
     printf("Load edges time (seconds): %.4lf\n", NANOSECTOSEC(load_edges_time_in_ns));
+    printf("Reorder vertices time (seconds): %.4lf\n", NANOSECTOSEC(reorder_time_in_ns));
     printf("Store graph and label file time (seconds): %.4lf\n", NANOSECTOSEC(store_graph_time_in_ns));
+    printf("Partition graph time (seconds): %.4lf\n", NANOSECTOSEC(partition_time_in_ns));
     std::cout << "End." << std::endl;
 
     return 0;
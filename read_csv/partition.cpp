@@ -0,0 +1,226 @@
+#include "partition.h"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <iostream>
+
+PartitionPolicy parsePartitionPolicy(const std::string &policy) {
+    if (policy.empty() || policy == "hash") {
+        return PartitionPolicy::Hash;
+    } else if (policy == "range") {
+        return PartitionPolicy::Range;
+    } else if (policy == "label") {
+        return PartitionPolicy::LabelAware;
+    }
+    std::cout << "wrong partition policy!" << std::endl;
+    return PartitionPolicy::Hash;
+}
+
+static inline ui hashVertex(VertexID v) {
+    uint64_t x = v + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return (ui)((x ^ (x >> 31)) >> 32);
+}
+
+static void rangePartition(std::vector<ui> &owner, ui partition_num, ui vertex_num,
+                           const ui* in_degree, const ui* out_degree) {
+    // every vertex weighs its degree plus one, so isolated vertices still spread out
+    uint64_t total_weight = 0;
+    for (ui i = 0; i < vertex_num; i++) {
+        total_weight += in_degree[i] + out_degree[i] + 1;
+    }
+    uint64_t prefix_weight = 0;
+    for (ui i = 0; i < vertex_num; i++) {
+        owner[i] = std::min<uint64_t>(prefix_weight * partition_num / total_weight, partition_num - 1);
+        prefix_weight += in_degree[i] + out_degree[i] + 1;
+    }
+}
+
+/*
+ * Linear deterministic greedy over the vertex stream: put each vertex where most
+ * of its already placed neighbors are, damped by how full that partition is.
+ * Capacities are per label, so every partition receives its share of each label.
+ */
+static void labelAwarePartition(std::vector<ui> &owner, ui partition_num, ui label_num,
+                                const ui* vertex_num_offset, const ui* in_degree, const ui* out_degree,
+                                VertexID** in_neighbors_array, VertexID** out_neighbors_array) {
+    const double slack = 1.05;
+    std::vector<ui> load(partition_num);
+    std::vector<ui> neighbor_count(partition_num, 0);
+    std::vector<ui> touched;
+
+    for (ui label = 0; label < label_num; label++) {
+        ui label_size = vertex_num_offset[label + 1] - vertex_num_offset[label];
+        double capacity = (double)label_size / partition_num * slack + 1;
+        std::fill(load.begin(), load.end(), 0);
+
+        for (VertexID v = vertex_num_offset[label]; v < vertex_num_offset[label + 1]; v++) {
+            VertexID** neighbor_arrays[2] = {in_neighbors_array, out_neighbors_array};
+            const ui* degrees[2] = {in_degree, out_degree};
+            for (ui d = 0; d < 2; d++) {
+                for (ui j = 0; j < degrees[d][v]; j++) {
+                    VertexID u = neighbor_arrays[d][v][j];
+                    if (owner[u] != UINT_MAX) {
+                        if (neighbor_count[owner[u]]++ == 0) {
+                            touched.push_back(owner[u]);
+                        }
+                    }
+                }
+            }
+
+            ui best = UINT_MAX;
+            double best_score = -1;
+            for (ui part = 0; part < partition_num; part++) {
+                if (load[part] + 1 > capacity) {
+                    continue;
+                }
+                double score = neighbor_count[part] * (1 - load[part] / capacity);
+                if (score > best_score || (score == best_score && load[part] < load[best])) {
+                    best = part;
+                    best_score = score;
+                }
+            }
+            if (best == UINT_MAX) {
+                best = std::min_element(load.begin(), load.end()) - load.begin();
+            }
+            owner[v] = best;
+            load[best]++;
+
+            for (auto part : touched) {
+                neighbor_count[part] = 0;
+            }
+            touched.clear();
+        }
+    }
+}
+
+std::vector<ui> computePartition(PartitionPolicy policy, ui partition_num, ui vertex_num, ui label_num,
+                                 const ui* vertex_num_offset, const ui* in_degree, const ui* out_degree,
+                                 VertexID** in_neighbors_array, VertexID** out_neighbors_array) {
+    std::vector<ui> owner(vertex_num, UINT_MAX);
+    if (policy == PartitionPolicy::Hash) {
+        for (ui i = 0; i < vertex_num; i++) {
+            owner[i] = hashVertex(i) % partition_num;
+        }
+    } else if (policy == PartitionPolicy::Range) {
+        rangePartition(owner, partition_num, vertex_num, in_degree, out_degree);
+    } else {
+        labelAwarePartition(owner, partition_num, label_num, vertex_num_offset, in_degree, out_degree,
+                            in_neighbors_array, out_neighbors_array);
+    }
+    return owner;
+}
+
+void writePartitions(const std::string &base_path, const std::vector<ui> &owner, ui partition_num,
+                     ui vertex_num, ui label_num, const ui* vertex_num_offset,
+                     const ui* in_degree, const ui* out_degree,
+                     VertexID** in_neighbors_array, VertexID** out_neighbors_array) {
+    std::vector<VertexID> local_id(vertex_num, UINT_MAX);
+    uint64_t cut_edge_num = 0;
+    uint64_t edge_num = 0;
+    std::vector<ui> owned_nums(partition_num);
+    std::vector<uint64_t> edge_nums(partition_num);
+
+    for (ui part = 0; part < partition_num; part++) {
+        std::vector<VertexID> owned;
+        std::vector<VertexID> ghosts;
+        for (ui i = 0; i < vertex_num; i++) {
+            if (owner[i] == part) {
+                owned.push_back(i);
+            }
+        }
+        for (auto v : owned) {
+            for (ui j = 0; j < in_degree[v]; j++) {
+                if (owner[in_neighbors_array[v][j]] != part) {
+                    ghosts.push_back(in_neighbors_array[v][j]);
+                }
+            }
+            for (ui j = 0; j < out_degree[v]; j++) {
+                if (owner[out_neighbors_array[v][j]] != part) {
+                    ghosts.push_back(out_neighbors_array[v][j]);
+                    cut_edge_num++;
+                }
+            }
+            edge_nums[part] += out_degree[v];
+        }
+        std::sort(ghosts.begin(), ghosts.end());
+        ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+
+        std::vector<VertexID> local_to_global(owned);
+        local_to_global.insert(local_to_global.end(), ghosts.begin(), ghosts.end());
+        for (ui i = 0; i < local_to_global.size(); i++) {
+            local_id[local_to_global[i]] = i;
+        }
+        std::vector<ui> ghost_owner(ghosts.size());
+        for (ui i = 0; i < ghosts.size(); i++) {
+            ghost_owner[i] = owner[ghosts[i]];
+        }
+
+        ui owned_num = owned.size();
+        ui ghost_num = ghosts.size();
+        std::vector<ui> local_in_degree(owned_num);
+        std::vector<ui> local_out_degree(owned_num);
+        std::vector<VertexID> in_lists;
+        std::vector<VertexID> out_lists;
+        std::vector<VertexID> boundary;
+        for (ui i = 0; i < owned_num; i++) {
+            VertexID v = owned[i];
+            bool is_boundary = false;
+            for (ui d = 0; d < 2; d++) {
+                std::vector<VertexID> &lists = d == 0 ? in_lists : out_lists;
+                ui degree = d == 0 ? in_degree[v] : out_degree[v];
+                VertexID* neighbors = d == 0 ? in_neighbors_array[v] : out_neighbors_array[v];
+                size_t list_start = lists.size();
+                for (ui j = 0; j < degree; j++) {
+                    lists.push_back(local_id[neighbors[j]]);
+                    is_boundary |= local_id[neighbors[j]] >= owned_num;
+                }
+                std::sort(lists.begin() + list_start, lists.end());
+            }
+            local_in_degree[i] = in_degree[v];
+            local_out_degree[i] = out_degree[v];
+            if (is_boundary) {
+                boundary.push_back(i);
+            }
+        }
+        ui boundary_num = boundary.size();
+
+        std::ofstream descriptor(base_path + ".part" + std::to_string(part), std::ios::binary);
+
+        ui magic = PARTITION_MAGIC;
+        ui size_vertex_num_offset = label_num + 1;
+        descriptor.write((char*)&magic, sizeof(ui));
+        descriptor.write((char*)&part, sizeof(ui));
+        descriptor.write((char*)&partition_num, sizeof(ui));
+        descriptor.write((char*)&vertex_num, sizeof(ui));
+        descriptor.write((char*)&size_vertex_num_offset, sizeof(ui));
+        descriptor.write((char*)vertex_num_offset, sizeof(ui) * size_vertex_num_offset);
+        descriptor.write((char*)&owned_num, sizeof(ui));
+        descriptor.write((char*)&ghost_num, sizeof(ui));
+        descriptor.write((char*)&boundary_num, sizeof(ui));
+        descriptor.write((char*)local_to_global.data(), sizeof(VertexID) * local_to_global.size());
+        descriptor.write((char*)ghost_owner.data(), sizeof(ui) * ghost_num);
+        descriptor.write((char*)boundary.data(), sizeof(VertexID) * boundary_num);
+        descriptor.write((char*)local_in_degree.data(), sizeof(ui) * owned_num);
+        descriptor.write((char*)local_out_degree.data(), sizeof(ui) * owned_num);
+        descriptor.write((char*)in_lists.data(), sizeof(VertexID) * in_lists.size());
+        descriptor.write((char*)out_lists.data(), sizeof(VertexID) * out_lists.size());
+
+        descriptor.close();
+
+        for (auto v : local_to_global) {
+            local_id[v] = UINT_MAX;
+        }
+        owned_nums[part] = owned_num;
+        edge_num += edge_nums[part];
+
+        std::cout << "\tpartition " << part << ": |V|: " << owned_num << " |E|: " << edge_nums[part]
+                  << " ghosts: " << ghost_num << " boundary: " << boundary_num << std::endl;
+    }
+
+    double vertex_balance = (double)*std::max_element(owned_nums.begin(), owned_nums.end()) * partition_num / std::max(1U, vertex_num);
+    double edge_balance = (double)*std::max_element(edge_nums.begin(), edge_nums.end()) * partition_num / std::max<uint64_t>(1, edge_num);
+    std::cout << "\tvertex balance (max/avg): " << vertex_balance << " edge balance (max/avg): " << edge_balance << std::endl;
+    std::cout << "\tedge cut: " << cut_edge_num << " (" << (edge_num == 0 ? 0 : 100.0 * cut_edge_num / edge_num) << "%)" << std::endl;
+}
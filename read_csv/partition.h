@@ -0,0 +1,46 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include "type.h"
+#include <string>
+#include <vector>
+
+enum PartitionPolicy {
+    Hash = 0,           // hashed vertex IDs
+    Range = 1,          // contiguous ID ranges with balanced degree sums
+    LabelAware = 2      // streaming greedy edge-cut minimization with a per-label capacity
+};
+
+PartitionPolicy parsePartitionPolicy(const std::string &policy);
+
+// Returns owner[v], the partition of every vertex
+std::vector<ui> computePartition(PartitionPolicy policy, ui partition_num, ui vertex_num, ui label_num,
+                                 const ui* vertex_num_offset, const ui* in_degree, const ui* out_degree,
+                                 VertexID** in_neighbors_array, VertexID** out_neighbors_array);
+
+/*
+ * Partition file (<graph>.part<i>), one per partition, edge-cut: a partition
+ * owns its vertices and all their edges, and the other endpoints of cut edges
+ * are kept as ghosts.
+ *
+ * Layout:
+ *   ui magic, ui partition_id, ui partition_num, ui global_vertex_num,
+ *   ui size_vertex_num_offset, ui vertex_num_offset[size_vertex_num_offset] (global, for labels),
+ *   ui owned_num, ui ghost_num, ui boundary_num,
+ *   VertexID local_to_global[owned_num + ghost_num], ui ghost_owner[ghost_num],
+ *   VertexID boundary[boundary_num],
+ *   ui in_degree[owned_num], ui out_degree[owned_num], in-neighbor lists, out-neighbor lists
+ * Local IDs 0..owned_num-1 are owned vertices and the rest ghosts, both in
+ * ascending global ID order, so global -> local is a binary search in either
+ * half of local_to_global. Neighbor lists hold sorted local IDs. Boundary
+ * vertices are owned vertices with at least one ghost neighbor.
+ */
+#define PARTITION_MAGIC 0x31545250     // "PRT1"
+
+// Writes <base_path>.part0 ... and prints balance and edge-cut statistics
+void writePartitions(const std::string &base_path, const std::vector<ui> &owner, ui partition_num,
+                     ui vertex_num, ui label_num, const ui* vertex_num_offset,
+                     const ui* in_degree, const ui* out_degree,
+                     VertexID** in_neighbors_array, VertexID** out_neighbors_array);
+
+#endif
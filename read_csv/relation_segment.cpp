@@ -0,0 +1,88 @@
+#include "relation_segment.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+std::string relationName(const std::string &file) {
+    std::string name = file.substr(0, file.rfind(".csv"));
+    // drop the partition suffixes, e.g. _0_0
+    for (int i = 0; i < 2; i++) {
+        size_t pos = name.rfind('_');
+        if (pos == std::string::npos || pos + 1 == name.size() ||
+            !std::all_of(name.begin() + pos + 1, name.end(), ::isdigit)) {
+            break;
+        }
+        name = name.substr(0, pos);
+    }
+    return name;
+}
+
+void remapRelationEdges(const std::vector<VertexID> &new_id, std::vector<RelationEdges> &relations) {
+    for (auto &relation : relations) {
+        for (auto &edge : relation.edges) {
+            edge.first = new_id[edge.first];
+            edge.second = new_id[edge.second];
+        }
+    }
+}
+
+// Writes the CSR of edges grouped by their first endpoint, edges must be sorted
+static void writeSegment(std::ofstream &descriptor, const std::vector<std::pair<VertexID, VertexID> > &edges) {
+    ui vertex_begin = 0;
+    ui vertex_end = 0;
+    if (!edges.empty()) {
+        vertex_begin = edges.front().first;
+        vertex_end = edges.back().first + 1;
+    }
+
+    std::vector<ui> offset(vertex_end - vertex_begin + 1, 0);
+    std::vector<VertexID> neighbors(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        offset[edges[i].first - vertex_begin + 1]++;
+        neighbors[i] = edges[i].second;
+    }
+    for (ui i = 0; i < vertex_end - vertex_begin; i++) {
+        offset[i + 1] += offset[i];
+    }
+
+    descriptor.write((char*)&vertex_begin, sizeof(ui));
+    descriptor.write((char*)&vertex_end, sizeof(ui));
+    descriptor.write((char*)offset.data(), sizeof(ui) * offset.size());
+    descriptor.write((char*)neighbors.data(), sizeof(VertexID) * neighbors.size());
+}
+
+void writeRelationSegments(const std::string &file_path, std::vector<RelationEdges> &relations) {
+    std::ofstream descriptor(file_path, std::ios::binary);
+
+    ui relation_num = relations.size();
+    std::vector<ui> name_offset(relation_num + 1);
+    std::string names;
+    name_offset[0] = 0;
+    for (ui i = 0; i < relation_num; i++) {
+        names += relations[i].name;
+        name_offset[i + 1] = names.size();
+    }
+
+    descriptor.write((char*)&relation_num, sizeof(ui));
+    descriptor.write((char*)name_offset.data(), sizeof(ui) * (relation_num + 1));
+    descriptor.write(names.data(), sizeof(char) * names.size());
+
+    for (auto &relation : relations) {
+        std::vector<std::pair<VertexID, VertexID> > &edges = relation.edges;
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        ui edge_num = edges.size();
+        descriptor.write((char*)&edge_num, sizeof(ui));
+        writeSegment(descriptor, edges);
+
+        std::vector<std::pair<VertexID, VertexID> > reversed_edges(edges.size());
+        for (size_t i = 0; i < edges.size(); i++) {
+            reversed_edges[i] = std::make_pair(edges[i].second, edges[i].first);
+        }
+        std::sort(reversed_edges.begin(), reversed_edges.end());
+        writeSegment(descriptor, reversed_edges);
+    }
+
+    descriptor.close();
+}
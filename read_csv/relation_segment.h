@@ -0,0 +1,38 @@
+#ifndef RELATION_SEGMENT_H
+#define RELATION_SEGMENT_H
+
+#include "type.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Relation-partitioned adjacency file (<graph>.rel).
+ *
+ * The data graph merges every edge file into one unlabeled adjacency, so parallel
+ * edges of different relations collapse. This file keeps one CSR segment per
+ * relation (e.g. person_knows_person), in both directions, using the final vertex IDs.
+ * A segment only covers the ID range its endpoints fall in, which is contiguous
+ * because labels own contiguous ID ranges.
+ *
+ * Layout:
+ *   ui relation_num, ui name_offset[relation_num + 1], char names[name_offset[relation_num]],
+ *   per relation: ui edge_num, out segment, in segment, each segment as
+ *     ui vertex_begin, ui vertex_end, ui offset[vertex_end - vertex_begin + 1], VertexID neighbors[edge_num]
+ * The neighbors of vertex v (vertex_begin <= v < vertex_end) are
+ * neighbors[offset[v - vertex_begin], offset[v - vertex_begin + 1]), sorted.
+ */
+struct RelationEdges {
+    std::string name;
+    std::vector<std::pair<VertexID, VertexID> > edges;      // (src, dest)
+};
+
+// Relation name of an edge file, e.g. person_knows_person_0_0.csv -> person_knows_person
+std::string relationName(const std::string &file);
+
+void remapRelationEdges(const std::vector<VertexID> &new_id, std::vector<RelationEdges> &relations);
+
+// Sorts and deduplicates the edges of every relation before writing
+void writeRelationSegments(const std::string &file_path, std::vector<RelationEdges> &relations);
+
+#endif
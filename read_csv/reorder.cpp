@@ -0,0 +1,234 @@
+#include "reorder.h"
+#include <algorithm>
+#include <queue>
+#include <cmath>
+#include <iostream>
+
+ReorderPolicy parseReorderPolicy(const std::string &policy) {
+    if (policy.empty() || policy == "original") {
+        return ReorderPolicy::Original;
+    } else if (policy == "degree") {
+        return ReorderPolicy::Degree;
+    } else if (policy == "rcm") {
+        return ReorderPolicy::RCM;
+    } else if (policy == "gorder") {
+        return ReorderPolicy::Gorder;
+    }
+    std::cout << "wrong reorder policy! (" << policy << "), keeping original order" << std::endl;
+    return ReorderPolicy::Original;
+}
+
+// contiguous copy of std::set adjacency, much faster to traverse repeatedly
+struct Adjacency {
+    std::vector<ui> offset;
+    std::vector<VertexID> neighbors;
+
+    Adjacency(const std::vector<std::set<VertexID> > &neighbor_sets) : offset(neighbor_sets.size() + 1, 0) {
+        for (size_t i = 0; i < neighbor_sets.size(); i++) {
+            offset[i + 1] = offset[i] + neighbor_sets[i].size();
+        }
+        neighbors.reserve(offset.back());
+        for (auto const& neighbor_set : neighbor_sets) {
+            neighbors.insert(neighbors.end(), neighbor_set.begin(), neighbor_set.end());
+        }
+    }
+
+    const VertexID* begin(VertexID v) const { return neighbors.data() + offset[v]; }
+    const VertexID* end(VertexID v) const { return neighbors.data() + offset[v + 1]; }
+    ui degree(VertexID v) const { return offset[v + 1] - offset[v]; }
+};
+
+static std::vector<VertexID> degreeOrder(ui vertex_num, const std::vector<ui> &degree) {
+    std::vector<VertexID> order(vertex_num);
+    for (ui i = 0; i < vertex_num; i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](VertexID a, VertexID b) {
+        return degree[a] > degree[b];
+    });
+    return order;
+}
+
+static std::vector<VertexID> rcmOrder(ui vertex_num, const std::vector<ui> &degree,
+                                      const Adjacency &in_neighbors, const Adjacency &out_neighbors) {
+    std::vector<VertexID> order;
+    order.reserve(vertex_num);
+    std::vector<bool> visited(vertex_num, false);
+
+    // start each component from its lowest-degree vertex
+    std::vector<VertexID> by_degree = degreeOrder(vertex_num, degree);
+    std::reverse(by_degree.begin(), by_degree.end());
+
+    std::vector<VertexID> frontier;
+    for (auto root : by_degree) {
+        if (visited[root]) {
+            continue;
+        }
+        visited[root] = true;
+        size_t head = order.size();
+        order.push_back(root);
+
+        while (head < order.size()) {
+            VertexID u = order[head++];
+            frontier.clear();
+            for (auto it = out_neighbors.begin(u); it != out_neighbors.end(u); ++it) {
+                VertexID v = *it;
+                if (!visited[v]) {
+                    visited[v] = true;
+                    frontier.push_back(v);
+                }
+            }
+            for (auto it = in_neighbors.begin(u); it != in_neighbors.end(u); ++it) {
+                VertexID v = *it;
+                if (!visited[v]) {
+                    visited[v] = true;
+                    frontier.push_back(v);
+                }
+            }
+            std::stable_sort(frontier.begin(), frontier.end(), [&](VertexID a, VertexID b) {
+                return degree[a] < degree[b];
+            });
+            order.insert(order.end(), frontier.begin(), frontier.end());
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+/*
+ * Gorder places next the vertex with the highest score against the last `window`
+ * placed vertices, where the score counts direct edges and shared in-neighbors
+ * (siblings). Scores are kept in an array with a lazy max-heap on top: every score
+ * change pushes a new entry and stale entries are skipped when popped. Sibling expansion skips hub in-neighbors with
+ * more than hub_degree out-neighbors, which would otherwise dominate the cost.
+ */
+static std::vector<VertexID> gorderOrder(ui vertex_num, const std::vector<ui> &degree,
+                                         const Adjacency &in_neighbors, const Adjacency &out_neighbors) {
+    const ui window = 5;
+    const ui hub_degree = std::max((ui)64, (ui)std::sqrt((double)vertex_num));
+
+    std::vector<VertexID> order;
+    order.reserve(vertex_num);
+    std::vector<bool> placed(vertex_num, false);
+    std::vector<int> score(vertex_num, 0);
+    std::priority_queue<std::pair<int, VertexID> > heap;
+
+    auto update = [&](VertexID v, int delta) {
+        auto touch = [&](VertexID u) {
+            if (!placed[u]) {
+                score[u] += delta;
+                if (score[u] > 0) {
+                    heap.push(std::make_pair(score[u], u));
+                }
+            }
+        };
+        for (auto it = out_neighbors.begin(v); it != out_neighbors.end(v); ++it) {
+            touch(*it);
+        }
+        for (auto it = in_neighbors.begin(v); it != in_neighbors.end(v); ++it) {
+            VertexID u = *it;
+            touch(u);
+            if (out_neighbors.degree(u) <= hub_degree) {
+                for (auto sibling = out_neighbors.begin(u); sibling != out_neighbors.end(u); ++sibling) {
+                    if (*sibling != v) {
+                        touch(*sibling);
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<VertexID> by_degree = degreeOrder(vertex_num, degree);
+    ui next_seed = 0;
+
+    while (order.size() < vertex_num) {
+        VertexID next = vertex_num;
+        while (!heap.empty()) {
+            auto top = heap.top();
+            heap.pop();
+            if (!placed[top.second] && top.first == score[top.second] && top.first > 0) {
+                next = top.second;
+                break;
+            }
+        }
+        if (next == vertex_num) {
+            // no vertex is related to the window, continue with the highest degree vertex left
+            while (placed[by_degree[next_seed]]) {
+                next_seed++;
+            }
+            next = by_degree[next_seed];
+        }
+
+        placed[next] = true;
+        order.push_back(next);
+        update(next, 1);
+
+        if (order.size() > window) {
+            update(order[order.size() - window - 1], -1);
+        }
+    }
+
+    return order;
+}
+
+std::vector<VertexID> computeReorder(ReorderPolicy policy, ui vertex_num, ui label_num, const ui* vertex_num_offset,
+                                     const std::vector<std::set<VertexID> > &in_neighbors,
+                                     const std::vector<std::set<VertexID> > &out_neighbors) {
+    std::vector<VertexID> new_id(vertex_num);
+    for (ui i = 0; i < vertex_num; i++) {
+        new_id[i] = i;
+    }
+    if (policy == ReorderPolicy::Original) {
+        return new_id;
+    }
+
+    std::vector<ui> degree(vertex_num);
+    for (ui i = 0; i < vertex_num; i++) {
+        degree[i] = in_neighbors[i].size() + out_neighbors[i].size();
+    }
+
+    std::vector<VertexID> order;
+    if (policy == ReorderPolicy::Degree) {
+        order = degreeOrder(vertex_num, degree);
+    } else {
+        Adjacency in_adjacency(in_neighbors);
+        Adjacency out_adjacency(out_neighbors);
+        if (policy == ReorderPolicy::RCM) {
+            order = rcmOrder(vertex_num, degree, in_adjacency, out_adjacency);
+        } else {
+            order = gorderOrder(vertex_num, degree, in_adjacency, out_adjacency);
+        }
+    }
+
+    // fill every label range in global order
+    std::vector<VertexID> next_in_label(vertex_num_offset, vertex_num_offset + label_num);
+    for (auto v : order) {
+        ui label = std::upper_bound(vertex_num_offset, vertex_num_offset + label_num + 1, v) - vertex_num_offset - 1;
+        new_id[v] = next_in_label[label]++;
+    }
+
+    return new_id;
+}
+
+void applyReorder(const std::vector<VertexID> &new_id, std::vector<std::set<VertexID> > &in_neighbors,
+                  std::vector<std::set<VertexID> > &out_neighbors) {
+    ui vertex_num = new_id.size();
+    std::vector<std::set<VertexID> > new_in_neighbors(vertex_num);
+    std::vector<std::set<VertexID> > new_out_neighbors(vertex_num);
+
+    for (ui i = 0; i < vertex_num; i++) {
+        for (auto v : in_neighbors[i]) {
+            new_in_neighbors[new_id[i]].insert(new_id[v]);
+        }
+        for (auto v : out_neighbors[i]) {
+            new_out_neighbors[new_id[i]].insert(new_id[v]);
+        }
+        // release memory as we go
+        std::set<VertexID>().swap(in_neighbors[i]);
+        std::set<VertexID>().swap(out_neighbors[i]);
+    }
+
+    in_neighbors.swap(new_in_neighbors);
+    out_neighbors.swap(new_out_neighbors);
+}
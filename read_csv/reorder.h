@@ -0,0 +1,31 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "type.h"
+#include <string>
+#include <vector>
+#include <set>
+
+enum ReorderPolicy {
+    Original = 0,       // keep the IDs assigned while reading vertices
+    Degree = 1,         // descending total degree
+    RCM = 2,            // reverse Cuthill-McKee over the undirected graph
+    Gorder = 3          // greedy windowed ordering maximizing shared neighbors (Gorder-style)
+};
+
+ReorderPolicy parseReorderPolicy(const std::string &policy);
+
+/*
+ * Compute a permutation new_id[old_id] which only moves vertices inside their
+ * own label range, so vertex_num_offset stays valid. The policy produces a global
+ * order of all vertices, and each label range is then filled in that order.
+ */
+std::vector<VertexID> computeReorder(ReorderPolicy policy, ui vertex_num, ui label_num, const ui* vertex_num_offset,
+                                     const std::vector<std::set<VertexID> > &in_neighbors,
+                                     const std::vector<std::set<VertexID> > &out_neighbors);
+
+// Relabel both adjacency structures in place
+void applyReorder(const std::vector<VertexID> &new_id, std::vector<std::set<VertexID> > &in_neighbors,
+                  std::vector<std::set<VertexID> > &out_neighbors);
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Number of threads parallelFor uses for n items
+inline unsigned parallelForThreads(unsigned n, unsigned min_chunk = 1024) {
+    return std::max(1U, std::min(std::thread::hardware_concurrency(), n / min_chunk + 1));
+}
+
+/*
+ * Run function(thread, begin, end) over [0, n) split into one contiguous range
+ * per hardware thread. Small inputs use fewer threads, at least min_chunk items each.
+ */
+template <typename Function>
+unsigned parallelFor(unsigned n, Function function, unsigned min_chunk = 1024) {
+    unsigned thread_num = parallelForThreads(n, min_chunk);
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < thread_num; t++) {
+        threads.emplace_back(function, t, (unsigned)((uint64_t)n * t / thread_num),
+                             (unsigned)((uint64_t)n * (t + 1) / thread_num));
+    }
+    function(0U, 0U, (unsigned)((uint64_t)n / thread_num));
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return thread_num;
+}
+
+#endif